@@ -0,0 +1,441 @@
+/*
+ * Archive.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+#include <link.h>
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Archive.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::BuildId
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct BuildId
+{
+    static std::string get()
+    {
+        std::string result;
+
+        auto callback = [](struct dl_phdr_info* info, size_t size, void* data) -> int
+        {
+            static const char digits[] = "0123456789abcdef";
+            std::string&      result(*reinterpret_cast<std::string*>(data));
+            for(int index = 0; index < info->dlpi_phnum; ++index) {
+                const ElfW(Phdr)& phdr(info->dlpi_phdr[index]);
+                if(phdr.p_type != PT_NOTE) {
+                    continue;
+                }
+                const uint8_t* note = reinterpret_cast<const uint8_t*>(info->dlpi_addr + phdr.p_vaddr);
+                const uint8_t* last = note + phdr.p_memsz;
+                while((note + sizeof(ElfW(Nhdr))) <= last) {
+                    const ElfW(Nhdr)* nhdr = reinterpret_cast<const ElfW(Nhdr)*>(note);
+                    const uint8_t*    name = note + sizeof(ElfW(Nhdr));
+                    const uint8_t*    desc = name + ((nhdr->n_namesz + 3) & ~3);
+                    if((nhdr->n_type == NT_GNU_BUILD_ID) && (nhdr->n_namesz == 4) && (::memcmp(name, "GNU", 4) == 0)) {
+                        for(size_t offset = 0; offset < nhdr->n_descsz; ++offset) {
+                            result += digits[(desc[offset] >> 4) & 0x0f];
+                            result += digits[(desc[offset] >> 0) & 0x0f];
+                        }
+                        return 1;
+                    }
+                    note = desc + ((nhdr->n_descsz + 3) & ~3);
+                }
+            }
+            return 1;
+        };
+
+        static_cast<void>(::dl_iterate_phdr(callback, &result));
+        if(result.empty()) {
+            struct stat status;
+            if(::stat("/proc/self/exe", &status) == 0) {
+                result = std::to_string(status.st_size) + '-' + std::to_string(status.st_mtime);
+            }
+        }
+        return result;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Mapping
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Mapping
+{
+    Mapping(const std::string& path)
+        : data(nullptr)
+        , size(0)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd != -1) {
+            struct stat status;
+            if((::fstat(fd, &status) == 0) && (status.st_size > 0)) {
+                void* address = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(address != MAP_FAILED) {
+                    data = reinterpret_cast<const uint8_t*>(address);
+                    size = status.st_size;
+                }
+            }
+            static_cast<void>(::close(fd));
+        }
+    }
+
+    ~Mapping()
+    {
+        if(data != nullptr) {
+            static_cast<void>(::munmap(const_cast<uint8_t*>(data), size));
+        }
+    }
+
+    const uint8_t* data;
+    size_t         size;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::EhFrame
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct EhFrame
+{
+    template <typename Transform>
+    static size_t rebase(uint8_t* data, const size_t size, Transform&& transform)
+    {
+        size_t offset = 0;
+
+        while(true) {
+            uint32_t length = 0;
+            uint32_t id     = 0;
+            if((offset + sizeof(length)) > size) {
+                throw std::runtime_error("invalid frame");
+            }
+            ::memcpy(&length, &data[offset], sizeof(length));
+            if(length == 0) {
+                return offset + sizeof(length);
+            }
+            if((length < sizeof(id)) || ((offset + sizeof(length) + length) > size)) {
+                throw std::runtime_error("invalid frame");
+            }
+            ::memcpy(&id, &data[offset + 4], sizeof(id));
+            if(id != 0) {
+                uint64_t value = 0;
+                if(length < 20) {
+                    throw std::runtime_error("invalid frame");
+                }
+                ::memcpy(&value, &data[offset + 8], sizeof(value));
+                value = transform(value);
+                ::memcpy(&data[offset + 8], &value, sizeof(value));
+            }
+            offset += sizeof(length) + length;
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Archive
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+constexpr uint32_t Archive::MAGIC;
+constexpr uint32_t Archive::VERSION;
+
+Archive::Archive()
+    : _directory()
+    , _build()
+{
+}
+
+void Archive::open(const std::string& directory)
+{
+    _directory = directory;
+    if(_directory.empty()) {
+        return;
+    }
+    if(_build.empty()) {
+        _build = BuildId::get();
+    }
+    if((::mkdir(_directory.c_str(), 0755) != 0) && (errno != EEXIST)) {
+        throw std::runtime_error(std::string("unable to create the directory") + ' ' + '<' + _directory + '>');
+    }
+}
+
+bool Archive::enabled() const
+{
+    return !_directory.empty();
+}
+
+bool Archive::load(const std::string& expression, const int mode, ByteCode& bytecode, HostCode& hostcode, Function& function)
+{
+    if((enabled() == false) || (hostcode.executable() == false)) {
+        return false;
+    }
+    const Mapping mapping(path(expression, mode));
+    const uint8_t* data = mapping.data;
+    size_t         size = mapping.size;
+    Header         header;
+
+    auto fetch = [&](const uint64_t length) -> const uint8_t*
+    {
+        const uint8_t* pointer = data;
+        if(length > size) {
+            throw std::runtime_error("truncated archive");
+        }
+        data += length;
+        size -= length;
+        return pointer;
+    };
+
+    try {
+        ::memcpy(&header, fetch(sizeof(header)), sizeof(header));
+        if((header.magic != MAGIC) || (header.version != VERSION) || (header.mode != static_cast<uint32_t>(mode))) {
+            return false;
+        }
+        if((header.build != _build.size()) || (header.expression != expression.size())) {
+            return false;
+        }
+        if(_build.compare(0, _build.size(), reinterpret_cast<const char*>(fetch(header.build)), header.build) != 0) {
+            return false;
+        }
+        if(expression.compare(0, expression.size(), reinterpret_cast<const char*>(fetch(header.expression)), header.expression) != 0) {
+            return false;
+        }
+        if((header.entry >= header.leave) || (header.leave > header.hostcode) || (header.loop_begin > header.loop_end) || (header.loop_end > header.hostcode)) {
+            return false;
+        }
+        const uint8_t* code = fetch(header.bytecode);
+        const uint8_t* host = fetch(header.hostcode);
+        std::vector<Relocation> relocations(header.relocations);
+        if(header.relocations != 0) {
+            ::memcpy(relocations.data(), fetch(header.relocations * sizeof(Relocation)), header.relocations * sizeof(Relocation));
+        }
+        std::vector<uint8_t> frames(header.frames);
+        if(header.frames != 0) {
+            ::memcpy(frames.data(), fetch(header.frames), header.frames);
+        }
+        if(size != 0) {
+            return false;
+        }
+        bytecode.clear();
+        bytecode.write(code, header.bytecode);
+        hostcode.clear();
+        function.clear();
+        hostcode.reserve(header.hostcode);
+        const uint8_t*       base = hostcode.end();
+        std::vector<uint8_t> text(host, host + header.hostcode);
+        for(auto& relocation : relocations) {
+            uint64_t value = 0;
+            if((relocation.offset + sizeof(value)) > text.size()) {
+                throw std::runtime_error("invalid relocation");
+            }
+            ::memcpy(&value, &text[relocation.offset], sizeof(value));
+            switch(relocation.kind) {
+                case HostCode::RELOC_FUNCTION:
+                    value = Symbols::table().at(relocation.symbol).address;
+                    break;
+                case HostCode::RELOC_CODE:
+                    value = reinterpret_cast<uintptr_t>(base) + value;
+                    break;
+                default:
+                    throw std::runtime_error("invalid relocation");
+            }
+            ::memcpy(&text[relocation.offset], &value, sizeof(value));
+        }
+        hostcode.write(text.data(), text.size());
+        BasicBlock block;
+        block.begin(base + header.entry);
+        block.end(base + header.leave);
+        function.add(block);
+        if(header.loop_begin < header.loop_end) {
+            BasicBlock loop;
+            loop.begin(base + header.loop_begin);
+            loop.end(base + header.loop_end);
+            function.add_loop(loop);
+        }
+        for(size_t offset = 0; offset < frames.size();) {
+            const size_t length = EhFrame::rebase(&frames[offset], (frames.size() - offset), [&](const uint64_t value) -> uint64_t
+            {
+                if(value >= header.hostcode) {
+                    throw std::runtime_error("invalid frame");
+                }
+                return reinterpret_cast<uintptr_t>(base) + value;
+            });
+            hostcode.add_frames(std::vector<uint8_t>(&frames[offset], &frames[offset] + length));
+            offset += length;
+        }
+    }
+    catch(const std::exception& e) {
+        bytecode.clear();
+        hostcode.clear();
+        function.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Archive::save(const std::string& expression, const int mode, const ByteCode& bytecode, const HostCode& hostcode, const Function& function)
+{
+    const uint8_t* base = hostcode.begin();
+    const size_t   size = hostcode.end() - hostcode.begin();
+
+    if((enabled() == false) || (function.callable() == false) || (hostcode.used() != size)) {
+        return false;
+    }
+    Header                  header;
+    std::vector<uint8_t>    text(base, base + size);
+    std::vector<Relocation> relocations;
+    std::vector<uint8_t>    frames;
+
+    auto offset = [&](const uint8_t* pointer) -> uint64_t
+    {
+        if((pointer == nullptr) || (pointer < base) || (pointer > (base + size))) {
+            throw std::runtime_error("invalid offset");
+        }
+        return pointer - base;
+    };
+
+    try {
+        for(auto& relocation : hostcode.relocations()) {
+            Relocation entry{offset(relocation.address), static_cast<uint32_t>(relocation.kind), 0};
+            uint64_t   value = 0;
+            if((entry.offset + sizeof(value)) > text.size()) {
+                throw std::runtime_error("invalid relocation");
+            }
+            ::memcpy(&value, &text[entry.offset], sizeof(value));
+            switch(relocation.kind) {
+                case HostCode::RELOC_FUNCTION:
+                    if(Symbols::find(value, entry.symbol) == false) {
+                        throw std::runtime_error("unknown symbol");
+                    }
+                    value = 0;
+                    break;
+                case HostCode::RELOC_CODE:
+                    value = offset(reinterpret_cast<const uint8_t*>(value));
+                    break;
+                default:
+                    throw std::runtime_error("invalid relocation");
+            }
+            ::memcpy(&text[entry.offset], &value, sizeof(value));
+            relocations.push_back(entry);
+        }
+        for(auto& eh_frame : hostcode.frames()) {
+            std::vector<uint8_t> records(eh_frame);
+            static_cast<void>(EhFrame::rebase(records.data(), records.size(), [&](const uint64_t value) -> uint64_t
+            {
+                return offset(reinterpret_cast<const uint8_t*>(value));
+            }));
+            frames.insert(frames.end(), records.begin(), records.end());
+        }
+        header.magic       = MAGIC;
+        header.version     = VERSION;
+        header.mode        = mode;
+        header.relocations = relocations.size();
+        header.build       = _build.size();
+        header.expression  = expression.size();
+        header.bytecode    = bytecode.end() - bytecode.begin();
+        header.hostcode    = text.size();
+        header.entry       = offset(function.begin());
+        header.leave       = offset(function.end());
+        header.loop_begin  = 0;
+        header.loop_end    = 0;
+        header.frames      = frames.size();
+        if(function.loop().valid()) {
+            header.loop_begin = offset(function.loop().begin());
+            header.loop_end   = offset(function.loop().end());
+        }
+    }
+    catch(const std::runtime_error& e) {
+        return false;
+    }
+    const std::string filename(path(expression, mode));
+    const std::string temporary(filename + '.' + std::to_string(::getpid()));
+    std::ofstream     stream(temporary, std::ios::binary | std::ios::trunc);
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(_build.data(), _build.size());
+    stream.write(expression.data(), expression.size());
+    stream.write(reinterpret_cast<const char*>(bytecode.begin()), header.bytecode);
+    stream.write(reinterpret_cast<const char*>(text.data()), text.size());
+    stream.write(reinterpret_cast<const char*>(relocations.data()), relocations.size() * sizeof(Relocation));
+    stream.write(reinterpret_cast<const char*>(frames.data()), frames.size());
+    stream.close();
+    if(stream.fail() || (::rename(temporary.c_str(), filename.c_str()) != 0)) {
+        static_cast<void>(::unlink(temporary.c_str()));
+        return false;
+    }
+    return true;
+}
+
+std::string Archive::path(const std::string& expression, const int mode) const
+{
+    static const char digits[] = "0123456789abcdef";
+    uint64_t          hash = 0xcbf29ce484222325;
+    std::string       name;
+
+    auto update = [&](const std::string& string) -> void
+    {
+        for(const char character : string) {
+            hash ^= static_cast<uint8_t>(character);
+            hash *= 0x100000001b3;
+        }
+        hash ^= 0xff;
+        hash *= 0x100000001b3;
+    };
+
+    update(_build);
+    update(std::to_string(mode));
+    update(expression);
+    for(int shift = 60; shift >= 0; shift -= 4) {
+        name += digits[(hash >> shift) & 0x0f];
+    }
+    return _directory + '/' + name + ".rpnc";
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+/*
+ * Archive.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Archive_h__
+#define __RPN_Archive_h__
+
+#include "State.h"
+#include "ByteCode.h"
+#include "HostCode.h"
+#include "Function.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Archive
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Archive
+{
+public: // public interface
+    Archive();
+
+    Archive(Archive&&) = delete;
+
+    Archive& operator=(Archive&&) = delete;
+
+    Archive(const Archive&) = delete;
+
+    Archive& operator=(const Archive&) = delete;
+
+    virtual ~Archive() = default;
+
+    void open(const std::string& directory);
+
+    bool enabled() const;
+
+    bool load(const std::string& expression, const int mode, ByteCode& bytecode, HostCode& hostcode, Function& function);
+
+    bool save(const std::string& expression, const int mode, const ByteCode& bytecode, const HostCode& hostcode, const Function& function);
+
+public: // public static data
+    static constexpr uint32_t MAGIC   = 0x43504e52;
+    static constexpr uint32_t VERSION = 3;
+
+private: // private interface
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t mode;
+        uint32_t relocations;
+        uint64_t build;
+        uint64_t expression;
+        uint64_t bytecode;
+        uint64_t hostcode;
+        uint64_t entry;
+        uint64_t leave;
+        uint64_t loop_begin;
+        uint64_t loop_end;
+        uint64_t frames;
+    };
+
+    struct Relocation
+    {
+        uint64_t offset;
+        uint32_t kind;
+        uint32_t symbol;
+    };
+
+    std::string path(const std::string& expression, const int mode) const;
+
+private: // private data
+    std::string _directory;
+    std::string _build;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Archive_h__ */
@@ -39,7 +39,9 @@
 
 namespace {
 
-using PointerToFunction = void(*)(void);
+using PointerToFunction = void(*)(rpn::Operands*);
+
+using PointerToLoop = void(*)(rpn::Operands*, uint64_t);
 
 }
 
@@ -49,9 +51,12 @@ using PointerToFunction = void(*)(void);
 
 namespace rpn {
 
+constexpr size_t BasicBlock::NO_ORIGIN;
+
 BasicBlock::BasicBlock()
     : _begin(nullptr)
     , _end(nullptr)
+    , _origin(NO_ORIGIN)
 {
 }
 
@@ -75,10 +80,16 @@ void BasicBlock::end(const uint8_t* end)
     }
 }
 
+void BasicBlock::origin(const size_t origin)
+{
+    _origin = origin;
+}
+
 void BasicBlock::reset()
 {
-    _begin = nullptr;
-    _end   = nullptr;
+    _begin  = nullptr;
+    _end    = nullptr;
+    _origin = NO_ORIGIN;
 }
 
 bool BasicBlock::valid() const
@@ -89,12 +100,26 @@ bool BasicBlock::valid() const
     return false;
 }
 
-void BasicBlock::execute() const
+void BasicBlock::execute(Operands& operands) const
 {
     PointerToFunction function = reinterpret_cast<PointerToFunction>(const_cast<uint8_t*>(_begin));
 
     if((_begin != nullptr) && (_end != nullptr) && (_begin < _end)) {
-        (*function)();
+        (*function)(&operands);
+        operands.check();
+    }
+    else {
+        throw std::runtime_error("cannot execute invalid basic block");
+    }
+}
+
+void BasicBlock::execute(Operands& operands, const uint64_t count) const
+{
+    PointerToLoop function = reinterpret_cast<PointerToLoop>(const_cast<uint8_t*>(_begin));
+
+    if((_begin != nullptr) && (_end != nullptr) && (_begin < _end)) {
+        (*function)(&operands, count);
+        operands.check();
     }
     else {
         throw std::runtime_error("cannot execute invalid basic block");
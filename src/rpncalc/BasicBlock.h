@@ -17,6 +17,8 @@
 #ifndef __RPN_BasicBlock_h__
 #define __RPN_BasicBlock_h__
 
+#include "State.h"
+
 // ---------------------------------------------------------------------------
 // rpn::BasicBlock
 // ---------------------------------------------------------------------------
@@ -38,19 +40,42 @@ public: // public interface
 
     virtual ~BasicBlock() = default;
 
+    const uint8_t* begin() const
+    {
+        return _begin;
+    }
+
+    const uint8_t* end() const
+    {
+        return _end;
+    }
+
+    size_t origin() const
+    {
+        return _origin;
+    }
+
     void begin(const uint8_t* begin);
 
     void end(const uint8_t* end);
 
+    void origin(const size_t origin);
+
     void reset();
 
     bool valid() const;
 
-    void execute() const;
+    void execute(Operands& operands) const;
+
+    void execute(Operands& operands, const uint64_t count) const;
+
+public: // public static data
+    static constexpr size_t NO_ORIGIN = SIZE_MAX;
 
 private: // private data
     const uint8_t* _begin;
     const uint8_t* _end;
+    size_t         _origin;
 };
 
 }
@@ -60,12 +60,23 @@ void Buffer::clear(const uint8_t value)
 
 void Buffer::write(const uint8_t value)
 {
-    if(_bufptr < (_buffer + _buflen)) {
-        *_bufptr++ = value;
+    if(_bufptr >= (_buffer + _buflen)) {
+        grow(1);
     }
-    else {
-        throw std::runtime_error("buffer is full");
+    *_bufptr++ = value;
+}
+
+void Buffer::write(const uint8_t* data, const size_t size)
+{
+    if(static_cast<size_t>((_buffer + _buflen) - _bufptr) < size) {
+        grow(size);
     }
+    _bufptr = std::copy(data, (data + size), _bufptr);
+}
+
+void Buffer::grow(const size_t size)
+{
+    throw std::runtime_error("buffer is full");
 }
 
 }
@@ -52,6 +52,11 @@ public: // public interface
 
     void write(const uint8_t value);
 
+    void write(const uint8_t* data, const size_t size);
+
+protected: // protected interface
+    virtual void grow(const size_t size);
+
 protected: // protected data
     uint8_t* _buffer;
     uint8_t* _bufptr;
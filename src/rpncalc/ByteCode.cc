@@ -57,6 +57,11 @@ void ByteCode::clear()
     Buffer::clear(OP_NOP);
 }
 
+void ByteCode::grow(const size_t size)
+{
+    Allocator::reallocate(*this, size);
+}
+
 void ByteCode::emit_byte(const uint8_t value)
 {
     Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
@@ -64,28 +69,40 @@ void ByteCode::emit_byte(const uint8_t value)
 
 void ByteCode::emit_word(const uint16_t value)
 {
-    Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >>  8) & 0xff));
+    const uint8_t bytes[2] = {
+        static_cast<uint8_t>((value >>  0) & 0xff),
+        static_cast<uint8_t>((value >>  8) & 0xff),
+    };
+
+    Buffer::write(bytes, sizeof(bytes));
 }
 
 void ByteCode::emit_long(const uint32_t value)
 {
-    Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >>  8) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 16) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 24) & 0xff));
+    const uint8_t bytes[4] = {
+        static_cast<uint8_t>((value >>  0) & 0xff),
+        static_cast<uint8_t>((value >>  8) & 0xff),
+        static_cast<uint8_t>((value >> 16) & 0xff),
+        static_cast<uint8_t>((value >> 24) & 0xff),
+    };
+
+    Buffer::write(bytes, sizeof(bytes));
 }
 
 void ByteCode::emit_quad(const uint64_t value)
 {
-    Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >>  8) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 16) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 24) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 32) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 40) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 48) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 56) & 0xff));
+    const uint8_t bytes[8] = {
+        static_cast<uint8_t>((value >>  0) & 0xff),
+        static_cast<uint8_t>((value >>  8) & 0xff),
+        static_cast<uint8_t>((value >> 16) & 0xff),
+        static_cast<uint8_t>((value >> 24) & 0xff),
+        static_cast<uint8_t>((value >> 32) & 0xff),
+        static_cast<uint8_t>((value >> 40) & 0xff),
+        static_cast<uint8_t>((value >> 48) & 0xff),
+        static_cast<uint8_t>((value >> 56) & 0xff),
+    };
+
+    Buffer::write(bytes, sizeof(bytes));
 }
 
 void ByteCode::emit_nop()
@@ -214,6 +231,149 @@ void ByteCode::emit_hlt()
     emit_byte(OP_HLT);
 }
 
+void ByteCode::emit_str(const uint8_t operand)
+{
+    emit_byte(OP_STR);
+    emit_byte(operand);
+}
+
+void ByteCode::emit_rcr(const uint8_t operand)
+{
+    emit_byte(OP_RCR);
+    emit_byte(operand);
+}
+
+void ByteCode::emit_adi(const int64_t operand)
+{
+    emit_byte(OP_ADI);
+    emit_quad(operand);
+}
+
+void ByteCode::emit_mui(const int64_t operand)
+{
+    emit_byte(OP_MUI);
+    emit_quad(operand);
+}
+
+void ByteCode::emit_stk(const uint8_t operand)
+{
+    emit_byte(OP_STK);
+    emit_byte(operand);
+}
+
+void ByteCode::emit_rcu(const uint8_t operand)
+{
+    emit_byte(OP_RCU);
+    emit_byte(operand);
+}
+
+void ByteCode::emit_dad()
+{
+    emit_byte(OP_DAD);
+}
+
+void ByteCode::emit_xsb()
+{
+    emit_byte(OP_XSB);
+}
+
+void ByteCode::emit_dvi(const int64_t operand)
+{
+    emit_byte(OP_DVI);
+    emit_quad(operand);
+}
+
+void ByteCode::emit_mdi(const int64_t operand)
+{
+    emit_byte(OP_MDI);
+    emit_quad(operand);
+}
+
+const char* ByteCode::mnemonic(const uint8_t opcode)
+{
+    switch(opcode) {
+        case OP_NOP: return "nop";
+        case OP_I64: return "i64";
+        case OP_TOP: return "top";
+        case OP_POP: return "pop";
+        case OP_CLR: return "clr";
+        case OP_DUP: return "dup";
+        case OP_XCH: return "xch";
+        case OP_STO: return "sto";
+        case OP_RCL: return "rcl";
+        case OP_ABS: return "abs";
+        case OP_NEG: return "neg";
+        case OP_ADD: return "add";
+        case OP_SUB: return "sub";
+        case OP_MUL: return "mul";
+        case OP_DIV: return "div";
+        case OP_MOD: return "mod";
+        case OP_CPL: return "cpl";
+        case OP_AND: return "and";
+        case OP_IOR: return "ior";
+        case OP_XOR: return "xor";
+        case OP_SHL: return "shl";
+        case OP_SHR: return "shr";
+        case OP_INC: return "inc";
+        case OP_DEC: return "dec";
+        case OP_HLT: return "hlt";
+        case OP_STR: return "str";
+        case OP_RCR: return "rcr";
+        case OP_ADI: return "adi";
+        case OP_MUI: return "mui";
+        case OP_STK: return "stk";
+        case OP_RCU: return "rcu";
+        case OP_DAD: return "dad";
+        case OP_XSB: return "xsb";
+        case OP_DVI: return "dvi";
+        case OP_MDI: return "mdi";
+        default:
+            break;
+    }
+    return "???";
+}
+
+std::string ByteCode::token(const uint8_t* opcode)
+{
+    if(*opcode == OP_I64) {
+        return std::to_string(operand(opcode));
+    }
+    if(length(*opcode) > 1) {
+        return std::string(mnemonic(*opcode)) + ' ' + std::to_string(operand(opcode));
+    }
+    return mnemonic(*opcode);
+}
+
+size_t ByteCode::length(const uint8_t opcode)
+{
+    switch(opcode) {
+        case OP_I64:
+        case OP_ADI:
+        case OP_MUI:
+        case OP_DVI:
+        case OP_MDI:
+            return 9;
+        case OP_STR:
+        case OP_RCR:
+        case OP_STK:
+        case OP_RCU:
+            return 2;
+        default:
+            break;
+    }
+    return 1;
+}
+
+int64_t ByteCode::operand(const uint8_t* opcode)
+{
+    uint64_t value = 0;
+
+    for(size_t index = length(*opcode) - 1; index > 0; --index) {
+        value = ((value << 8) | opcode[index]);
+    }
+    return static_cast<int64_t>(value);
+}
+
 }
 
 // ---------------------------------------------------------------------------
@@ -237,6 +397,23 @@ void ByteCode::Allocator::allocate(ByteCode& bytecode)
     bytecode.clear();
 }
 
+void ByteCode::Allocator::reallocate(ByteCode& bytecode, const size_t size)
+{
+    auto& _buffer(bytecode._buffer);
+    auto& _bufptr(bytecode._bufptr);
+    auto& _buflen(bytecode._buflen);
+
+    const size_t used   = (_bufptr - _buffer);
+    const size_t buflen = std::max((_buflen * 2), (used + size));
+    uint8_t*     buffer = new uint8_t[buflen];
+
+    std::fill(std::copy(_buffer, _bufptr, buffer), (buffer + buflen), static_cast<uint8_t>(OP_NOP));
+    delete[] _buffer;
+    _buffer = buffer;
+    _bufptr = buffer + used;
+    _buflen = buflen;
+}
+
 void ByteCode::Allocator::deallocate(ByteCode& bytecode)
 {
     auto& _buffer(bytecode._buffer);
@@ -101,6 +101,34 @@ public: // public interface
 
     void emit_hlt();
 
+    void emit_str(const uint8_t operand);
+
+    void emit_rcr(const uint8_t operand);
+
+    void emit_adi(const int64_t operand);
+
+    void emit_mui(const int64_t operand);
+
+    void emit_stk(const uint8_t operand);
+
+    void emit_rcu(const uint8_t operand);
+
+    void emit_dad();
+
+    void emit_xsb();
+
+    void emit_dvi(const int64_t operand);
+
+    void emit_mdi(const int64_t operand);
+
+    static const char* mnemonic(const uint8_t opcode);
+
+    static std::string token(const uint8_t* opcode);
+
+    static size_t length(const uint8_t opcode);
+
+    static int64_t operand(const uint8_t* opcode);
+
 public: // public static data
     static constexpr uint8_t OP_NOP = 0x00;
     static constexpr uint8_t OP_I64 = 0x01;
@@ -127,12 +155,27 @@ public: // public static data
     static constexpr uint8_t OP_INC = 0x16;
     static constexpr uint8_t OP_DEC = 0x17;
     static constexpr uint8_t OP_HLT = 0x18;
+    static constexpr uint8_t OP_STR = 0x19;
+    static constexpr uint8_t OP_RCR = 0x1a;
+    static constexpr uint8_t OP_ADI = 0x1b;
+    static constexpr uint8_t OP_MUI = 0x1c;
+    static constexpr uint8_t OP_STK = 0x1d;
+    static constexpr uint8_t OP_RCU = 0x1e;
+    static constexpr uint8_t OP_DAD = 0x1f;
+    static constexpr uint8_t OP_XSB = 0x20;
+    static constexpr uint8_t OP_DVI = 0x21;
+    static constexpr uint8_t OP_MDI = 0x22;
+
+protected: // protected interface
+    virtual void grow(const size_t size) override;
 
 private: // private interface
     struct Allocator
     {
         static void allocate(ByteCode&);
 
+        static void reallocate(ByteCode&, const size_t size);
+
         static void deallocate(ByteCode&);
     };
 };
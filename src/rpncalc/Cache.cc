@@ -0,0 +1,120 @@
+/*
+ * Cache.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Cache.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Cache
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Cache::Cache()
+    : _items()
+    , _index()
+    , _capacity(0)
+    , _hits(0)
+    , _misses(0)
+{
+}
+
+std::shared_ptr<Registry::Entry> Cache::lookup(const std::string& key)
+{
+    auto iterator = _index.find(key);
+
+    if(iterator == _index.end()) {
+        ++_misses;
+        return nullptr;
+    }
+    _items.splice(_items.begin(), _items, iterator->second);
+    ++_hits;
+
+    return iterator->second->entry;
+}
+
+void Cache::insert(const std::string& key, const std::shared_ptr<Registry::Entry>& entry)
+{
+    auto iterator = _index.find(key);
+
+    if(iterator != _index.end()) {
+        _items.erase(iterator->second);
+        _index.erase(iterator);
+    }
+    _items.push_front(Item{key, entry});
+    _index.emplace(key, _items.begin());
+
+    return evict();
+}
+
+void Cache::resize(const size_t capacity)
+{
+    _capacity = capacity;
+
+    return evict();
+}
+
+void Cache::for_each(const std::function<void(Registry::Entry&)>& callback)
+{
+    for(auto& item : _items) {
+        callback(*item.entry);
+    }
+}
+
+std::string Cache::normalize(const std::string& expression)
+{
+    std::istringstream stream(expression);
+    std::string        result;
+    std::string        token;
+
+    while(stream >> token) {
+        if(!result.empty()) {
+            result += ' ';
+        }
+        result += token;
+    }
+    return result;
+}
+
+void Cache::evict()
+{
+    while(_items.size() > _capacity) {
+        _index.erase(_items.back().key);
+        _items.pop_back();
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+/*
+ * Cache.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Cache_h__
+#define __RPN_Cache_h__
+
+#include <list>
+#include <unordered_map>
+#include "Registry.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Cache
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Cache
+{
+public: // public interface
+    Cache();
+
+    Cache(Cache&&) = delete;
+
+    Cache& operator=(Cache&&) = delete;
+
+    Cache(const Cache&) = delete;
+
+    Cache& operator=(const Cache&) = delete;
+
+    virtual ~Cache() = default;
+
+    std::shared_ptr<Registry::Entry> lookup(const std::string& key);
+
+    void insert(const std::string& key, const std::shared_ptr<Registry::Entry>& entry);
+
+    void resize(const size_t capacity);
+
+    void for_each(const std::function<void(Registry::Entry&)>& callback);
+
+    bool enabled() const
+    {
+        return _capacity != 0;
+    }
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    size_t size() const
+    {
+        return _items.size();
+    }
+
+    uint64_t hits() const
+    {
+        return _hits;
+    }
+
+    uint64_t misses() const
+    {
+        return _misses;
+    }
+
+    static std::string normalize(const std::string& expression);
+
+private: // private interface
+    struct Item
+    {
+        std::string                      key;
+        std::shared_ptr<Registry::Entry> entry;
+    };
+
+    using Items = std::list<Item>;
+    using Index = std::unordered_map<std::string, Items::iterator>;
+
+    void evict();
+
+private: // private data
+    Items    _items;
+    Index    _index;
+    size_t   _capacity;
+    uint64_t _hits;
+    uint64_t _misses;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Cache_h__ */
@@ -45,7 +45,12 @@ struct VirtualMachine
 
     static void compile(Calculator&, Operands&, ByteCode&, HostCode&, Function&, const std::string& expression);
 
-    static void run(Calculator&, Operands&, ByteCode&, HostCode&, Function&);
+    static void run(Calculator&, const std::string& name, Operands&, ByteCode&, HostCode&, Function&, Tiering&, const int mode, const uint64_t count);
+
+    static void dispatch(Calculator&, Operands&, ByteCode&, HostCode&, Function&, const int mode, const int pass);
+
+    static constexpr int PASS_TRANSLATE = 0;
+    static constexpr int PASS_GENERATE  = 1;
 };
 
 }
@@ -61,17 +66,39 @@ Calculator::Calculator(Console& console)
     , Logger()
     , _console(console)
     , _operands()
-    , _bytecode()
-    , _hostcode()
-    , _function()
+    , _registry()
+    , _cache()
+    , _archive()
+    , _profiler()
+    , _mode(Translator::MODE_OPTIMIZING)
+    , _tiered(false)
+    , _dump_bytecode(false)
+    , _dump_hostcode(false)
 {
 }
 
 void Calculator::execute(const std::string& expression)
 {
+    auto& entry(acquire(std::string()));
+    std::shared_ptr<Registry::Entry> cache;
+
     log_print(std::string("executing expression") + ' ' + '<' + expression + '>');
+    if(_cache.enabled()) {
+        try {
+            cache = cached(std::string(), expression);
+        }
+        catch(const std::runtime_error& e) {
+            log_trace("the expression cannot be compiled, parsing the expression...");
+        }
+    }
     try {
-        VirtualMachine::execute(*this, _operands, _bytecode, _hostcode, _function, expression);
+        if(cache) {
+            VirtualMachine::run(*this, std::string(), _operands, cache->bytecode, cache->hostcode, cache->function, cache->tiering, _mode, 1);
+            store(*cache);
+        }
+        else {
+            VirtualMachine::execute(*this, _operands, entry.bytecode, entry.hostcode, entry.function, expression);
+        }
     }
     catch(const std::runtime_error& e) {
         log_error("error while executing!");
@@ -83,27 +110,64 @@ void Calculator::execute(const std::string& expression)
 void Calculator::compile(const std::string& expression)
 {
     log_print(std::string("compiling expression") + ' ' + '<' + expression + '>');
-    try {
-        VirtualMachine::compile(*this, _operands, _bytecode, _hostcode, _function, expression);
-    }
-    catch(const std::runtime_error& e) {
-        log_error("error while compiling!");
-        throw;
-    }
-    log_result();
+
+    return define(std::string(), expression);
+}
+
+void Calculator::compile(const std::string& expression, const std::string& name)
+{
+    log_print(std::string("compiling expression") + ' ' + '<' + expression + '>' + ' ' + "as" + ' ' + '<' + name + '>');
+
+    validate(name);
+
+    return define(name, expression);
 }
 
 void Calculator::run()
 {
     log_print("running the compiled expression...");
+
+    return run(std::string(), acquire(std::string()), 1, 0);
+}
+
+void Calculator::run(const uint64_t count, const uint64_t every)
+{
+    log_print(std::string("running the compiled expression") + ' ' + '<' + std::to_string(count) + '>' + ' ' + "times...");
+
+    return run(std::string(), acquire(std::string()), count, every);
+}
+
+void Calculator::run(const std::string& name, const uint64_t count, const uint64_t every)
+{
+    log_print(std::string("running the function") + ' ' + '<' + name + '>' + ' ' + '<' + std::to_string(count) + '>' + ' ' + "times...");
+
+    validate(name);
+
+    return run(name, _registry.lookup(name), count, every);
+}
+
+void Calculator::aot(const std::string& name)
+{
+    const std::string symbol(std::string("rpn_") + name);
+    const std::string filename(symbol + ".o");
+
+    log_print(std::string("exporting the function") + ' ' + '<' + name + '>' + ' ' + "to" + ' ' + '<' + filename + '>');
     try {
-        VirtualMachine::run(*this, _operands, _bytecode, _hostcode, _function);
+        validate(name);
+        auto&    entry(_registry.lookup(name));
+        HostCode hostcode;
+        Function function;
+        if(hostcode.executable() == false) {
+            throw std::runtime_error("the code buffer is unavailable");
+        }
+        VirtualMachine::dispatch(*this, _operands, entry.bytecode, hostcode, function, _mode, VirtualMachine::PASS_GENERATE);
+        Object object(hostcode, function);
+        object.write(symbol, filename);
     }
     catch(const std::runtime_error& e) {
-        log_error("error while running!");
+        log_error("error while exporting!");
         throw;
     }
-    log_result();
 }
 
 void Calculator::clear()
@@ -124,6 +188,264 @@ int64_t Calculator::result()
     return Operators::op_top(_operands);
 }
 
+void Calculator::set_mode(const int mode)
+{
+    auto invalidate = [&](Registry::Entry& entry) -> void
+    {
+        entry.hostcode.clear();
+        entry.function.clear();
+        entry.tiering.reset();
+        entry.archived = false;
+    };
+
+    if(_mode != mode) {
+        _mode = mode;
+        _registry.for_each(invalidate);
+        _cache.for_each(invalidate);
+    }
+}
+
+void Calculator::set_tiered(const bool enabled)
+{
+    auto invalidate = [&](Registry::Entry& entry) -> void
+    {
+        entry.tiering.enable(enabled);
+        entry.hostcode.clear();
+        entry.function.clear();
+        entry.tiering.reset();
+        entry.archived = false;
+    };
+
+    if(_tiered != enabled) {
+        _tiered = enabled;
+        _registry.for_each(invalidate);
+        _cache.for_each(invalidate);
+    }
+}
+
+void Calculator::set_cache(const size_t capacity)
+{
+    _cache.resize(capacity);
+}
+
+void Calculator::set_archive(const std::string& directory)
+{
+    _archive.open(directory);
+}
+
+void Calculator::set_stack(const size_t capacity)
+{
+    _operands.reserve(capacity);
+}
+
+void Calculator::set_perf_map()
+{
+    _profiler.open_perf_map();
+}
+
+void Calculator::set_jitdump()
+{
+    _profiler.open_jitdump();
+}
+
+void Calculator::set_dump(const std::string& what)
+{
+    if(what == "bytecode") {
+        _dump_bytecode = true;
+    }
+    else if(what == "hostcode") {
+        _dump_hostcode = true;
+    }
+    else {
+        throw std::runtime_error(std::string("invalid dump") + ' ' + '<' + what + '>');
+    }
+}
+
+void Calculator::publish(const std::string& name, const ByteCode& bytecode, HostCode& hostcode, const Function& function)
+{
+    const std::string symbol(name.empty() ? Profiler::label(bytecode) : std::string("rpn") + ':' + name);
+
+    _profiler.load(symbol, bytecode, function);
+    if(_dump_hostcode) {
+        dump(bytecode, function);
+    }
+    for(auto& image : DebugInfo(bytecode, function).images(symbol)) {
+        hostcode.add_symfile(image);
+    }
+}
+
+void Calculator::validate(const std::string& name) const
+{
+    if(name.empty()) {
+        throw std::runtime_error("empty function name");
+    }
+    for(const char character : name) {
+        if((::isalnum(static_cast<unsigned char>(character)) == 0) && (character != '_')) {
+            throw std::runtime_error(std::string("invalid function name") + ' ' + '<' + name + '>');
+        }
+    }
+}
+
+Registry::Entry& Calculator::acquire(const std::string& name)
+{
+    auto& entry(_registry.acquire(name));
+
+    if(entry.tiering.enabled() != _tiered) {
+        entry.tiering.enable(_tiered);
+    }
+    return entry;
+}
+
+std::shared_ptr<Registry::Entry> Calculator::cached(const std::string& name, const std::string& expression)
+{
+    const std::string key(Cache::normalize(expression));
+    auto              entry(_cache.lookup(key));
+
+    auto statistics = [&]() -> std::string
+    {
+        return std::to_string(_cache.hits()) + ' ' + "hit(s)" + ',' + ' ' + std::to_string(_cache.misses()) + ' ' + "miss(es)";
+    };
+
+    if(entry) {
+        log_trace(std::string("compilation cache hit") + ' ' + '<' + statistics() + '>');
+    }
+    else {
+        log_trace(std::string("compilation cache miss") + ' ' + '<' + statistics() + '>');
+        entry = std::make_shared<Registry::Entry>();
+        entry->tiering.enable(_tiered);
+        build(name, *entry, expression);
+        _cache.insert(key, entry);
+    }
+    return entry;
+}
+
+void Calculator::define(const std::string& name, const std::string& expression)
+{
+    try {
+        if(_cache.enabled()) {
+            _registry.assign(name, cached(name, expression));
+        }
+        else {
+            build(name, acquire(name), expression);
+        }
+    }
+    catch(const std::runtime_error& e) {
+        log_error("error while compiling!");
+        throw;
+    }
+    log_result();
+}
+
+void Calculator::build(const std::string& name, Registry::Entry& entry, const std::string& expression)
+{
+    entry.tiering.reset();
+    entry.expression = Cache::normalize(expression);
+    entry.archived   = false;
+    if(_archive.load(entry.expression, _mode, entry.bytecode, entry.hostcode, entry.function)) {
+        log_trace("the expression has been loaded from the archive, skipping the translation...");
+        while(entry.tiering.tier() != Tiering::TIER_OPTIMIZING) {
+            entry.tiering.promote();
+        }
+        entry.archived = true;
+        if(_dump_bytecode) {
+            dump(entry.bytecode);
+        }
+        publish(name, entry.bytecode, entry.hostcode, entry.function);
+        return;
+    }
+    VirtualMachine::compile(*this, _operands, entry.bytecode, entry.hostcode, entry.function, expression);
+    if(_dump_bytecode) {
+        dump(entry.bytecode);
+    }
+}
+
+void Calculator::store(Registry::Entry& entry)
+{
+    if((entry.archived != false) || (_archive.enabled() == false)) {
+        return;
+    }
+    if((entry.tiering.tier() == Tiering::TIER_OPTIMIZING) && entry.function.callable()) {
+        if(_archive.save(entry.expression, _mode, entry.bytecode, entry.hostcode, entry.function)) {
+            log_trace("the machine code has been saved to the archive");
+        }
+        else {
+            log_alert("unable to save the machine code to the archive");
+        }
+        entry.archived = true;
+    }
+}
+
+void Calculator::run(const std::string& name, Registry::Entry& entry, const uint64_t count, const uint64_t every)
+{
+    uint64_t remaining = count;
+
+    while(remaining > 0) {
+        const uint64_t chunk = ((every != 0) && (every < remaining) ? every : remaining);
+        try {
+            VirtualMachine::run(*this, name, _operands, entry.bytecode, entry.hostcode, entry.function, entry.tiering, _mode, chunk);
+            store(entry);
+        }
+        catch(const std::runtime_error& e) {
+            log_error("error while running!");
+            throw;
+        }
+        remaining -= chunk;
+        log_result();
+    }
+}
+
+void Calculator::dump(const ByteCode& bytecode)
+{
+    char buffer[32];
+
+    _console.println(std::string("bytecode") + ' ' + '<' + std::to_string(bytecode.end() - bytecode.begin()) + ' ' + "byte(s)" + '>');
+    for(const uint8_t* opcode = bytecode.begin(); opcode < bytecode.end(); opcode += ByteCode::length(*opcode)) {
+        static_cast<void>(::snprintf(buffer, sizeof(buffer), "%08lx  ", static_cast<unsigned long>(opcode - bytecode.begin())));
+        _console.println(std::string(buffer) + ByteCode::token(opcode));
+    }
+}
+
+void Calculator::dump(const ByteCode& bytecode, const Function& function)
+{
+    size_t bytes = 0;
+    size_t count = 0;
+
+    auto block = [&](const BasicBlock& basic_block, const std::string& label) -> void
+    {
+        Disassembler                disassembler(basic_block.begin(), basic_block.end());
+        Disassembler::Instruction   instruction;
+        if(basic_block.begin() == basic_block.end()) {
+            return;
+        }
+        _console.println(std::string(";") + ' ' + label);
+        while(disassembler.next(instruction)) {
+            _console.println(Disassembler::format(instruction));
+            bytes += instruction.length;
+            count += 1;
+        }
+    };
+
+    auto label = [&](const BasicBlock& basic_block) -> std::string
+    {
+        char buffer[32];
+        if(basic_block.origin() == BasicBlock::NO_ORIGIN) {
+            return (&basic_block == &function.basic_blocks().front() ? "prolog" : "epilog");
+        }
+        static_cast<void>(::snprintf(buffer, sizeof(buffer), "%08lx  ", static_cast<unsigned long>(basic_block.origin())));
+        return std::string(buffer) + ByteCode::token(bytecode.begin() + basic_block.origin());
+    };
+
+    if(function.callable() == false) {
+        return;
+    }
+    _console.println(std::string("hostcode") + ' ' + '<' + Profiler::label(bytecode) + '>');
+    for(auto& basic_block : function.basic_blocks()) {
+        block(basic_block, label(basic_block));
+    }
+    block(function.loop(), "loop");
+    _console.println(std::string("hostcode") + ' ' + '<' + std::to_string(bytes) + ' ' + "byte(s)" + ',' + ' ' + std::to_string(count) + ' ' + "instruction(s)" + '>');
+}
+
 void Calculator::op_nop()
 {
     static_cast<void>(Operators::op_nop(_operands));
@@ -249,9 +571,61 @@ void Calculator::op_hlt()
     static_cast<void>(Operators::op_hlt(_operands));
 }
 
+void Calculator::op_str(const int64_t operand)
+{
+    static_cast<void>(Operators::op_str(_operands, operand));
+}
+
+void Calculator::op_rcr(const int64_t operand)
+{
+    static_cast<void>(Operators::op_rcr(_operands, operand));
+}
+
+void Calculator::op_adi(const int64_t operand)
+{
+    static_cast<void>(Operators::op_adi(_operands, operand));
+}
+
+void Calculator::op_mui(const int64_t operand)
+{
+    static_cast<void>(Operators::op_mui(_operands, operand));
+}
+
+void Calculator::op_stk(const int64_t operand)
+{
+    static_cast<void>(Operators::op_stk(_operands, operand));
+}
+
+void Calculator::op_rcu(const int64_t operand)
+{
+    static_cast<void>(Operators::op_rcu(_operands, operand));
+}
+
+void Calculator::op_dad()
+{
+    static_cast<void>(Operators::op_dad(_operands));
+}
+
+void Calculator::op_xsb()
+{
+    static_cast<void>(Operators::op_xsb(_operands));
+}
+
+void Calculator::op_dvi(const int64_t operand)
+{
+    static_cast<void>(Operators::op_dvi(_operands, operand));
+}
+
+void Calculator::op_mdi(const int64_t operand)
+{
+    static_cast<void>(Operators::op_mdi(_operands, operand));
+}
+
 void Calculator::op_run()
 {
-    VirtualMachine::run(*this, _operands, _bytecode, _hostcode, _function);
+    auto& entry(acquire(std::string()));
+
+    VirtualMachine::run(*this, std::string(), _operands, entry.bytecode, entry.hostcode, entry.function, entry.tiering, _mode, 1);
 }
 
 void Calculator::log_debug(const std::string& message)
@@ -331,495 +705,628 @@ void VirtualMachine::execute(Calculator& calculator, Operands& operands, ByteCod
 
 void VirtualMachine::compile(Calculator& calculator, Operands& operands, ByteCode& bytecode, HostCode& hostcode, Function& function, const std::string& expression)
 {
-    Compiler compiler(bytecode, hostcode, function);
+    Compiler  compiler(bytecode, hostcode, function);
+    Optimizer optimizer(bytecode);
 
     compiler.compile(expression);
+    optimizer.optimize();
 }
 
-void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& bytecode, HostCode& hostcode, Function& function)
+void VirtualMachine::run(Calculator& calculator, const std::string& name, Operands& operands, ByteCode& bytecode, HostCode& hostcode, Function& function, Tiering& tiering, const int mode, const uint64_t count)
 {
-    auto log_debug = [&](const std::string& message) -> void
+    auto log_trace = [&](const std::string& message) -> void
     {
-        calculator.log_debug(message);
+        calculator.log_trace(message);
     };
 
-    auto log_trace = [&](const std::string& message) -> void
+    auto log_alert = [&](const std::string& message) -> void
     {
-        calculator.log_trace(message);
+        calculator.log_alert(message);
+    };
+
+    auto interpret = [&](const uint64_t count) -> void
+    {
+        Interpreter interpreter(operands, bytecode);
+
+        if(hostcode.executable()) {
+            log_trace("the bytecode is cold, interpreting the bytecode...");
+        }
+        else {
+            log_trace("the executable memory is unavailable, interpreting the bytecode...");
+        }
+        interpreter.execute(count);
+        tiering.account(count);
     };
 
+    auto translate = [&]() -> void
+    {
+        const int tier_mode = (tiering.enabled() ? Translator::MODE_BASELINE : mode);
+
+        log_trace("the bytecode has never been translated, executing bytecode and translating to machine code...");
+        try {
+            dispatch(calculator, operands, bytecode, hostcode, function, tier_mode, PASS_TRANSLATE);
+        }
+        catch(...) {
+            hostcode.clear();
+            function.clear();
+            throw;
+        }
+        calculator.publish(name, bytecode, hostcode, function);
+        tiering.account(1);
+        tiering.promote();
+    };
+
+    auto recompile = [&]() -> void
+    {
+        Function optimized;
+
+        if(mode != Translator::MODE_BASELINE) {
+            log_trace("the bytecode is hot, recompiling the bytecode to machine code...");
+            try {
+                dispatch(calculator, operands, bytecode, hostcode, optimized, mode, PASS_GENERATE);
+                function.swap(optimized);
+                calculator.publish(name, bytecode, hostcode, function);
+            }
+            catch(const std::runtime_error& e) {
+                log_alert(std::string("unable to recompile the bytecode") + ' ' + '<' + e.what() + '>');
+            }
+        }
+        tiering.promote();
+    };
+
+    auto execute = [&](const uint64_t count, const bool translated) -> void
+    {
+        if(translated) {
+            log_trace("the bytecode has been translated, executing the generated machine code...");
+        }
+        else {
+            log_trace("the bytecode has already been translated, executing the generated machine code...");
+        }
+        function.execute(operands, count);
+        tiering.account(count);
+    };
+
+    uint64_t remaining  = count;
+    bool     translated = false;
+    while(remaining > 0) {
+        const uint64_t budget = tiering.budget();
+        const uint64_t chunk  = std::min(remaining, budget);
+        if(hostcode.executable() == false) {
+            interpret(remaining);
+            remaining = 0;
+        }
+        else if(chunk == 0) {
+            if(tiering.tier() == Tiering::TIER_INTERPRETER) {
+                translate();
+                translated = true;
+                --remaining;
+            }
+            else {
+                recompile();
+            }
+        }
+        else if(tiering.tier() == Tiering::TIER_INTERPRETER) {
+            interpret(chunk);
+            remaining -= chunk;
+        }
+        else {
+            execute(chunk, translated);
+            remaining -= chunk;
+        }
+    }
+}
+
+void VirtualMachine::dispatch(Calculator& calculator, Operands& operands, ByteCode& bytecode, HostCode& hostcode, Function& function, const int mode, const int pass)
+{
+    const bool executing = (pass != PASS_GENERATE);
+
+    auto log_debug = [&](const std::string& message) -> void
+    {
+        calculator.log_debug(message);
+    };
+
+    Translator translator(bytecode, hostcode, function, mode);
+
     auto exec_nop = [&]() -> void
     {
-        log_debug("exec <nop>");
-        calculator.op_nop();
+        if(executing) {
+            log_debug("exec <nop>");
+            calculator.op_nop();
+        }
     };
 
     auto exec_i64 = [&](const int64_t operand) -> void
     {
-        log_debug("exec <i64>");
-        calculator.op_i64(operand);
+        if(executing) {
+            log_debug("exec <i64>");
+            calculator.op_i64(operand);
+        }
     };
 
     auto exec_top = [&]() -> void
     {
-        log_debug("exec <top>");
-        calculator.op_top();
+        if(executing) {
+            log_debug("exec <top>");
+            calculator.op_top();
+        }
     };
 
     auto exec_pop = [&]() -> void
     {
-        log_debug("exec <pop>");
-        calculator.op_pop();
+        if(executing) {
+            log_debug("exec <pop>");
+            calculator.op_pop();
+        }
     };
 
     auto exec_clr = [&]() -> void
     {
-        log_debug("exec <clr>");
-        calculator.op_clr();
+        if(executing) {
+            log_debug("exec <clr>");
+            calculator.op_clr();
+        }
     };
 
     auto exec_dup = [&]() -> void
     {
-        log_debug("exec <dup>");
-        calculator.op_dup();
+        if(executing) {
+            log_debug("exec <dup>");
+            calculator.op_dup();
+        }
     };
 
     auto exec_xch = [&]() -> void
     {
-        log_debug("exec <xch>");
-        calculator.op_xch();
+        if(executing) {
+            log_debug("exec <xch>");
+            calculator.op_xch();
+        }
     };
 
     auto exec_sto = [&]() -> void
     {
-        log_debug("exec <sto>");
-        calculator.op_sto();
+        if(executing) {
+            log_debug("exec <sto>");
+            calculator.op_sto();
+        }
     };
 
     auto exec_rcl = [&]() -> void
     {
-        log_debug("exec <rcl>");
-        calculator.op_rcl();
+        if(executing) {
+            log_debug("exec <rcl>");
+            calculator.op_rcl();
+        }
     };
 
     auto exec_abs = [&]() -> void
     {
-        log_debug("exec <abs>");
-        calculator.op_abs();
+        if(executing) {
+            log_debug("exec <abs>");
+            calculator.op_abs();
+        }
     };
 
     auto exec_neg = [&]() -> void
     {
-        log_debug("exec <neg>");
-        calculator.op_neg();
+        if(executing) {
+            log_debug("exec <neg>");
+            calculator.op_neg();
+        }
     };
 
     auto exec_add = [&]() -> void
     {
-        log_debug("exec <add>");
-        calculator.op_add();
+        if(executing) {
+            log_debug("exec <add>");
+            calculator.op_add();
+        }
     };
 
     auto exec_sub = [&]() -> void
     {
-        log_debug("exec <sub>");
-        calculator.op_sub();
+        if(executing) {
+            log_debug("exec <sub>");
+            calculator.op_sub();
+        }
     };
 
     auto exec_mul = [&]() -> void
     {
-        log_debug("exec <mul>");
-        calculator.op_mul();
+        if(executing) {
+            log_debug("exec <mul>");
+            calculator.op_mul();
+        }
     };
 
     auto exec_div = [&]() -> void
     {
-        log_debug("exec <div>");
-        calculator.op_div();
+        if(executing) {
+            log_debug("exec <div>");
+            calculator.op_div();
+        }
     };
 
     auto exec_mod = [&]() -> void
     {
-        log_debug("exec <mod>");
-        calculator.op_mod();
+        if(executing) {
+            log_debug("exec <mod>");
+            calculator.op_mod();
+        }
     };
 
     auto exec_cpl = [&]() -> void
     {
-        log_debug("exec <cpl>");
-        calculator.op_cpl();
+        if(executing) {
+            log_debug("exec <cpl>");
+            calculator.op_cpl();
+        }
     };
 
     auto exec_and = [&]() -> void
     {
-        log_debug("exec <and>");
-        calculator.op_and();
+        if(executing) {
+            log_debug("exec <and>");
+            calculator.op_and();
+        }
     };
 
     auto exec_ior = [&]() -> void
     {
-        log_debug("exec <ior>");
-        calculator.op_ior();
+        if(executing) {
+            log_debug("exec <ior>");
+            calculator.op_ior();
+        }
     };
 
     auto exec_xor = [&]() -> void
     {
-        log_debug("exec <xor>");
-        calculator.op_xor();
+        if(executing) {
+            log_debug("exec <xor>");
+            calculator.op_xor();
+        }
     };
 
     auto exec_shl = [&]() -> void
     {
-        log_debug("exec <shl>");
-        calculator.op_shl();
+        if(executing) {
+            log_debug("exec <shl>");
+            calculator.op_shl();
+        }
     };
 
     auto exec_shr = [&]() -> void
     {
-        log_debug("exec <shr>");
-        calculator.op_shr();
+        if(executing) {
+            log_debug("exec <shr>");
+            calculator.op_shr();
+        }
     };
 
     auto exec_inc = [&]() -> void
     {
-        log_debug("exec <inc>");
-        calculator.op_inc();
+        if(executing) {
+            log_debug("exec <inc>");
+            calculator.op_inc();
+        }
     };
 
     auto exec_dec = [&]() -> void
     {
-        log_debug("exec <dec>");
-        calculator.op_dec();
+        if(executing) {
+            log_debug("exec <dec>");
+            calculator.op_dec();
+        }
     };
 
     auto exec_hlt = [&]() -> void
     {
-        log_debug("exec <hlt>");
-        calculator.op_hlt();
+        if(executing) {
+            log_debug("exec <hlt>");
+            calculator.op_hlt();
+        }
+    };
+
+    auto exec_str = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <str>");
+            calculator.op_str(operand);
+        }
+    };
+
+    auto exec_rcr = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <rcr>");
+            calculator.op_rcr(operand);
+        }
+    };
+
+    auto exec_adi = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <adi>");
+            calculator.op_adi(operand);
+        }
+    };
+
+    auto exec_mui = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <mui>");
+            calculator.op_mui(operand);
+        }
+    };
+
+    auto exec_stk = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <stk>");
+            calculator.op_stk(operand);
+        }
+    };
+
+    auto exec_rcu = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <rcu>");
+            calculator.op_rcu(operand);
+        }
+    };
+
+    auto exec_dad = [&]() -> void
+    {
+        if(executing) {
+            log_debug("exec <dad>");
+            calculator.op_dad();
+        }
+    };
+
+    auto exec_xsb = [&]() -> void
+    {
+        if(executing) {
+            log_debug("exec <xsb>");
+            calculator.op_xsb();
+        }
+    };
+
+    auto exec_dvi = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <dvi>");
+            calculator.op_dvi(operand);
+        }
+    };
+
+    auto exec_mdi = [&](const int64_t operand) -> void
+    {
+        if(executing) {
+            log_debug("exec <mdi>");
+            calculator.op_mdi(operand);
+        }
     };
 
     auto emit_prolog = [&]() -> void
     {
         log_debug("emit <function prolog>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.push_rbp();
-        hostcode.mov_rbp_rsp();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_prolog();
     };
 
     auto emit_epilog = [&]() -> void
     {
         log_debug("emit <function epilog>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rsp_rbp();
-        hostcode.pop_rbp();
-        hostcode.ret();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_epilog();
     };
 
     auto emit_nop = [&]() -> void
     {
         log_debug("emit <nop>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_nop));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_nop();
     };
 
     auto emit_i64 = [&](const int64_t operand) -> void
     {
         log_debug("emit <i64>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rsi_imm64(operand);
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_i64));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_i64(operand);
     };
 
     auto emit_top = [&]() -> void
     {
         log_debug("emit <top>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_top));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_top();
     };
 
     auto emit_pop = [&]() -> void
     {
         log_debug("emit <pop>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_pop));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_pop();
     };
 
     auto emit_clr = [&]() -> void
     {
         log_debug("emit <clr>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_clr));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_clr();
     };
 
     auto emit_dup = [&]() -> void
     {
         log_debug("emit <dup>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_dup));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_dup();
     };
 
     auto emit_xch = [&]() -> void
     {
         log_debug("emit <xch>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_xch));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_xch();
     };
 
     auto emit_sto = [&]() -> void
     {
         log_debug("emit <sto>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_sto));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_sto();
     };
 
     auto emit_rcl = [&]() -> void
     {
         log_debug("emit <rcl>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_rcl));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_rcl();
     };
 
     auto emit_abs = [&]() -> void
     {
         log_debug("emit <abs>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_abs));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_abs();
     };
 
     auto emit_neg = [&]() -> void
     {
         log_debug("emit <neg>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_neg));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_neg();
     };
 
     auto emit_add = [&]() -> void
     {
         log_debug("emit <add>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_add));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_add();
     };
 
     auto emit_sub = [&]() -> void
     {
         log_debug("emit <sub>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_sub));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_sub();
     };
 
     auto emit_mul = [&]() -> void
     {
         log_debug("emit <mul>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_mul));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_mul();
     };
 
     auto emit_div = [&]() -> void
     {
         log_debug("emit <div>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_div));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_div();
     };
 
     auto emit_mod = [&]() -> void
     {
         log_debug("emit <mod>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_mod));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_mod();
     };
 
     auto emit_cpl = [&]() -> void
     {
         log_debug("emit <cpl>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_cpl));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_cpl();
     };
 
     auto emit_and = [&]() -> void
     {
         log_debug("emit <and>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_and));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_and();
     };
 
     auto emit_ior = [&]() -> void
     {
         log_debug("emit <ior>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_ior));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_ior();
     };
 
     auto emit_xor = [&]() -> void
     {
         log_debug("emit <xor>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_xor));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_xor();
     };
 
     auto emit_shl = [&]() -> void
     {
         log_debug("emit <shl>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_shl));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_shl();
     };
 
     auto emit_shr = [&]() -> void
     {
         log_debug("emit <shr>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_shr));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_shr();
     };
 
     auto emit_inc = [&]() -> void
     {
         log_debug("emit <inc>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_inc));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_inc();
     };
 
     auto emit_dec = [&]() -> void
     {
         log_debug("emit <dec>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_dec));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_dec();
     };
 
     auto emit_hlt = [&]() -> void
     {
         log_debug("emit <hlt>");
-        BasicBlock bb;
-        bb.begin(hostcode.end());
-        hostcode.mov_rdi_imm64(reinterpret_cast<uintptr_t>(&operands));
-        hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Operators::op_hlt));
-        hostcode.call_rax();
-        bb.end(hostcode.end());
-        function.add(bb);
+        translator.emit_hlt();
+    };
+
+    auto emit_str = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <str>");
+        translator.emit_str(operand);
+    };
+
+    auto emit_rcr = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <rcr>");
+        translator.emit_rcr(operand);
+    };
+
+    auto emit_adi = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <adi>");
+        translator.emit_adi(operand);
+    };
+
+    auto emit_mui = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <mui>");
+        translator.emit_mui(operand);
+    };
+
+    auto emit_stk = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <stk>");
+        translator.emit_stk(operand);
+    };
+
+    auto emit_rcu = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <rcu>");
+        translator.emit_rcu(operand);
+    };
+
+    auto emit_dad = [&]() -> void
+    {
+        log_debug("emit <dad>");
+        translator.emit_dad();
+    };
+
+    auto emit_xsb = [&]() -> void
+    {
+        log_debug("emit <xsb>");
+        translator.emit_xsb();
+    };
+
+    auto emit_dvi = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <dvi>");
+        translator.emit_dvi(operand);
+    };
+
+    auto emit_mdi = [&](const int64_t operand) -> void
+    {
+        log_debug("emit <mdi>");
+        translator.emit_mdi(operand);
     };
 
     auto prolog = [&]() -> void
@@ -827,9 +1334,26 @@ void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& b
         emit_prolog();
     };
 
+    auto emit_loop = [&]() -> void
+    {
+        log_debug("emit <function loop>");
+        translator.emit_loop();
+    };
+
+    auto usage = [&]() -> void
+    {
+        const std::string used(std::to_string(hostcode.used()));
+        const std::string capacity(std::to_string(hostcode.capacity()));
+        const std::string chunks(std::to_string(hostcode.chunks()));
+
+        log_debug(std::string("code cache usage") + ' ' + '<' + used + '/' + capacity + ' ' + "bytes" + ',' + ' ' + chunks + ' ' + "chunk(s)" + '>');
+    };
+
     auto epilog = [&]() -> void
     {
         emit_epilog();
+        emit_loop();
+        usage();
     };
 
     auto op_nop = [&](const uint8_t& opcode) -> int
@@ -839,7 +1363,7 @@ void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& b
         return 0;
     };
 
-    auto op_i64 = [&](const uint8_t& opcode) -> int
+    auto fetch_i64 = [&](const uint8_t& opcode) -> int64_t
     {
         int64_t operand = 0;
         operand = ((operand << 8) | (&opcode)[8]);
@@ -850,6 +1374,12 @@ void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& b
         operand = ((operand << 8) | (&opcode)[3]);
         operand = ((operand << 8) | (&opcode)[2]);
         operand = ((operand << 8) | (&opcode)[1]);
+        return operand;
+    };
+
+    auto op_i64 = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = fetch_i64(opcode);
         exec_i64(operand);
         emit_i64(operand);
         return 8;
@@ -1016,11 +1546,92 @@ void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& b
         return 0;
     };
 
+    auto op_str = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = (&opcode)[1];
+        exec_str(operand);
+        emit_str(operand);
+        return 1;
+    };
+
+    auto op_rcr = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = (&opcode)[1];
+        exec_rcr(operand);
+        emit_rcr(operand);
+        return 1;
+    };
+
+    auto op_adi = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = fetch_i64(opcode);
+        exec_adi(operand);
+        emit_adi(operand);
+        return 8;
+    };
+
+    auto op_mui = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = fetch_i64(opcode);
+        exec_mui(operand);
+        emit_mui(operand);
+        return 8;
+    };
+
+    auto op_stk = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = (&opcode)[1];
+        exec_stk(operand);
+        emit_stk(operand);
+        return 1;
+    };
+
+    auto op_rcu = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = (&opcode)[1];
+        exec_rcu(operand);
+        emit_rcu(operand);
+        return 1;
+    };
+
+    auto op_dad = [&](const uint8_t& opcode) -> int
+    {
+        exec_dad();
+        emit_dad();
+        return 0;
+    };
+
+    auto op_xsb = [&](const uint8_t& opcode) -> int
+    {
+        exec_xsb();
+        emit_xsb();
+        return 0;
+    };
+
+    auto op_dvi = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = fetch_i64(opcode);
+        exec_dvi(operand);
+        emit_dvi(operand);
+        return 8;
+    };
+
+    auto op_mdi = [&](const uint8_t& opcode) -> int
+    {
+        const int64_t operand = fetch_i64(opcode);
+        exec_mdi(operand);
+        emit_mdi(operand);
+        return 8;
+    };
+
     auto translate = [&]() -> void
     {
         prolog();
         int skip = 0;
         for(const uint8_t& opcode : bytecode) {
+            if(skip == 0) {
+                translator.origin(&opcode - bytecode.begin());
+            }
             if(skip > 0) {
                 --skip;
             }
@@ -1100,6 +1711,36 @@ void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& b
                 case ByteCode::OP_HLT:
                     skip = op_hlt(opcode);
                     break;
+                case ByteCode::OP_STR:
+                    skip = op_str(opcode);
+                    break;
+                case ByteCode::OP_RCR:
+                    skip = op_rcr(opcode);
+                    break;
+                case ByteCode::OP_ADI:
+                    skip = op_adi(opcode);
+                    break;
+                case ByteCode::OP_MUI:
+                    skip = op_mui(opcode);
+                    break;
+                case ByteCode::OP_STK:
+                    skip = op_stk(opcode);
+                    break;
+                case ByteCode::OP_RCU:
+                    skip = op_rcu(opcode);
+                    break;
+                case ByteCode::OP_DAD:
+                    skip = op_dad(opcode);
+                    break;
+                case ByteCode::OP_XSB:
+                    skip = op_xsb(opcode);
+                    break;
+                case ByteCode::OP_DVI:
+                    skip = op_dvi(opcode);
+                    break;
+                case ByteCode::OP_MDI:
+                    skip = op_mdi(opcode);
+                    break;
                 default:
                     throw std::runtime_error("unexpected opcode");
             }
@@ -1107,19 +1748,7 @@ void VirtualMachine::run(Calculator& calculator, Operands& operands, ByteCode& b
         epilog();
     };
 
-    auto execute = [&]() -> void
-    {
-        if(function.callable()) {
-            log_trace("the bytecode has already been translated, executing the generated machine code...");
-            function.execute();
-        }
-        else {
-            log_trace("the bytecode has never been translated, executing bytecode and translating to machine code...");
-            translate();
-        }
-    };
-
-    return execute();
+    return translate();
 }
 
 }
@@ -21,6 +21,17 @@
 #include "Console.h"
 #include "Parser.h"
 #include "Compiler.h"
+#include "Optimizer.h"
+#include "Interpreter.h"
+#include "Translator.h"
+#include "Tiering.h"
+#include "Registry.h"
+#include "Cache.h"
+#include "Archive.h"
+#include "Object.h"
+#include "Profiler.h"
+#include "DebugInfo.h"
+#include "Disassembler.h"
 #include "State.h"
 
 // ---------------------------------------------------------------------------
@@ -50,12 +61,38 @@ public: // public interface
 
     void compile(const std::string& expression);
 
+    void compile(const std::string& expression, const std::string& name);
+
     void run();
 
+    void run(const uint64_t count, const uint64_t every);
+
+    void run(const std::string& name, const uint64_t count, const uint64_t every);
+
+    void aot(const std::string& name);
+
     void clear();
 
     int64_t result();
 
+    void set_mode(const int mode);
+
+    void set_tiered(const bool enabled);
+
+    void set_cache(const size_t capacity);
+
+    void set_archive(const std::string& directory);
+
+    void set_stack(const size_t capacity);
+
+    void set_perf_map();
+
+    void set_jitdump();
+
+    void set_dump(const std::string& what);
+
+    void publish(const std::string& name, const ByteCode& bytecode, HostCode& hostcode, const Function& function);
+
 public: // listener interface
     virtual void op_nop() override;
 
@@ -107,6 +144,26 @@ public: // listener interface
 
     virtual void op_hlt() override;
 
+    virtual void op_str(const int64_t operand) override;
+
+    virtual void op_rcr(const int64_t operand) override;
+
+    virtual void op_adi(const int64_t operand) override;
+
+    virtual void op_mui(const int64_t operand) override;
+
+    virtual void op_stk(const int64_t operand) override;
+
+    virtual void op_rcu(const int64_t operand) override;
+
+    virtual void op_dad() override;
+
+    virtual void op_xsb() override;
+
+    virtual void op_dvi(const int64_t operand) override;
+
+    virtual void op_mdi(const int64_t operand) override;
+
     virtual void op_run() override;
 
 public: // logger interface
@@ -132,12 +189,36 @@ public: // logger interface
 
     void log_result();
 
+private: // private interface
+    void validate(const std::string& name) const;
+
+    Registry::Entry& acquire(const std::string& name);
+
+    std::shared_ptr<Registry::Entry> cached(const std::string& name, const std::string& expression);
+
+    void define(const std::string& name, const std::string& expression);
+
+    void build(const std::string& name, Registry::Entry& entry, const std::string& expression);
+
+    void store(Registry::Entry& entry);
+
+    void run(const std::string& name, Registry::Entry& entry, const uint64_t count, const uint64_t every);
+
+    void dump(const ByteCode& bytecode);
+
+    void dump(const ByteCode& bytecode, const Function& function);
+
 private: // private data
     Console& _console;
     Operands _operands;
-    ByteCode _bytecode;
-    HostCode _hostcode;
-    Function _function;
+    Registry _registry;
+    Cache    _cache;
+    Archive  _archive;
+    Profiler _profiler;
+    int      _mode;
+    bool     _tiered;
+    bool     _dump_bytecode;
+    bool     _dump_hostcode;
 };
 
 }
@@ -0,0 +1,411 @@
+/*
+ * DebugInfo.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <elf.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "DebugInfo.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Section
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Section
+{
+    static constexpr uint16_t NUL          = 0;
+    static constexpr uint16_t TEXT         = 1;
+    static constexpr uint16_t SYMTAB       = 2;
+    static constexpr uint16_t STRTAB       = 3;
+    static constexpr uint16_t DEBUG_ABBREV = 4;
+    static constexpr uint16_t DEBUG_INFO   = 5;
+    static constexpr uint16_t DEBUG_LINE   = 6;
+    static constexpr uint16_t SHSTRTAB     = 7;
+    static constexpr uint16_t COUNT        = 8;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Dwarf
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Dwarf
+{
+    static constexpr uint8_t  TAG_COMPILE_UNIT = 0x11;
+    static constexpr uint8_t  CHILDREN_NO      = 0x00;
+    static constexpr uint8_t  AT_NAME          = 0x03;
+    static constexpr uint8_t  AT_STMT_LIST     = 0x10;
+    static constexpr uint8_t  AT_LOW_PC        = 0x11;
+    static constexpr uint8_t  AT_HIGH_PC       = 0x12;
+    static constexpr uint8_t  FORM_ADDR        = 0x01;
+    static constexpr uint8_t  FORM_DATA4       = 0x06;
+    static constexpr uint8_t  FORM_STRING      = 0x08;
+    static constexpr uint8_t  LNS_COPY         = 0x01;
+    static constexpr uint8_t  LNS_ADVANCE_PC   = 0x02;
+    static constexpr uint8_t  LNS_ADVANCE_LINE = 0x03;
+    static constexpr uint8_t  LNS_SET_FILE     = 0x04;
+    static constexpr uint8_t  LNE_END_SEQUENCE = 0x01;
+    static constexpr uint8_t  LNE_SET_ADDRESS  = 0x02;
+    static constexpr uint8_t  LINE_BASE        = 0xfb;
+    static constexpr uint8_t  LINE_RANGE       = 14;
+    static constexpr uint8_t  OPCODE_BASE      = 13;
+    static constexpr uint16_t VERSION          = 2;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::DebugInfo
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+DebugInfo::DebugInfo(const ByteCode& bytecode, const Function& function)
+    : _bytecode(bytecode)
+    , _function(function)
+{
+}
+
+std::vector<std::vector<uint8_t>> DebugInfo::images(const std::string& name) const
+{
+    std::vector<std::vector<uint8_t>> images;
+
+    if(_function.callable() == false) {
+        return images;
+    }
+    for(auto& range : _function.ranges()) {
+        images.push_back(image(range, (range.loop ? name + ".loop" : name)));
+    }
+    return images;
+}
+
+std::vector<uint8_t> DebugInfo::image(const Function::Range& range, const std::string& name) const
+{
+    const uint64_t                  low_pc  = reinterpret_cast<uintptr_t>(range.begin);
+    const uint64_t                  high_pc = reinterpret_cast<uintptr_t>(range.end);
+    std::vector<uint8_t>            image(sizeof(Elf64_Ehdr));
+    std::vector<Elf64_Shdr>         sections(Section::COUNT);
+    std::vector<Elf64_Sym>          symbols(1);
+    std::vector<uint8_t>            debug_abbrev;
+    std::vector<uint8_t>            debug_info;
+    std::vector<uint8_t>            debug_line;
+    std::vector<Line>               lines;
+    std::vector<std::string>        files(1, name);
+    std::map<std::string, uint32_t> indexes;
+    std::map<size_t, uint32_t>      positions;
+    std::string                     strtab(1, '\0');
+    std::string                     shstrtab(1, '\0');
+
+    auto append = [&](const void* data, const size_t size, const size_t alignment) -> size_t
+    {
+        while((image.size() % alignment) != 0) {
+            image.push_back(0);
+        }
+        const size_t   offset = image.size();
+        const uint8_t* bytes  = reinterpret_cast<const uint8_t*>(data);
+        image.insert(image.end(), bytes, bytes + size);
+        return offset;
+    };
+
+    auto intern = [&](std::string& table, const std::string& string) -> uint32_t
+    {
+        const uint32_t offset = table.size();
+        table += string;
+        table += '\0';
+        return offset;
+    };
+
+    auto emit_byte = [&](std::vector<uint8_t>& buffer, const uint8_t value) -> void
+    {
+        buffer.push_back(value);
+    };
+
+    auto emit_word = [&](std::vector<uint8_t>& buffer, const uint16_t value) -> void
+    {
+        emit_byte(buffer, value >> 0);
+        emit_byte(buffer, value >> 8);
+    };
+
+    auto emit_long = [&](std::vector<uint8_t>& buffer, const uint32_t value) -> void
+    {
+        for(int shift = 0; shift < 32; shift += 8) {
+            emit_byte(buffer, value >> shift);
+        }
+    };
+
+    auto emit_quad = [&](std::vector<uint8_t>& buffer, const uint64_t value) -> void
+    {
+        for(int shift = 0; shift < 64; shift += 8) {
+            emit_byte(buffer, value >> shift);
+        }
+    };
+
+    auto emit_uleb = [&](std::vector<uint8_t>& buffer, uint64_t value) -> void
+    {
+        do {
+            const uint8_t byte = (value & 0x7f);
+            value >>= 7;
+            emit_byte(buffer, (value != 0 ? (byte | 0x80) : byte));
+        } while(value != 0);
+    };
+
+    auto emit_sleb = [&](std::vector<uint8_t>& buffer, int64_t value) -> void
+    {
+        bool more = true;
+        while(more) {
+            const uint8_t byte = (value & 0x7f);
+            value >>= 7;
+            more = !(((value == 0) && ((byte & 0x40) == 0)) || ((value == -1) && ((byte & 0x40) != 0)));
+            emit_byte(buffer, (more ? (byte | 0x80) : byte));
+        }
+    };
+
+    auto emit_string = [&](std::vector<uint8_t>& buffer, const std::string& value) -> void
+    {
+        buffer.insert(buffer.end(), value.begin(), value.end());
+        emit_byte(buffer, 0);
+    };
+
+    auto patch_long = [&](std::vector<uint8_t>& buffer, const size_t offset, const uint32_t value) -> void
+    {
+        for(int shift = 0; shift < 32; shift += 8) {
+            buffer[offset + (shift / 8)] = (value >> shift);
+        }
+    };
+
+    auto file_index = [&](const std::string& token) -> uint32_t
+    {
+        auto found = indexes.find(token);
+        if(found == indexes.end()) {
+            files.push_back(token);
+            found = indexes.emplace(token, files.size()).first;
+        }
+        return found->second;
+    };
+
+    auto build_lines = [&]() -> void
+    {
+        uint32_t position = 0;
+        for(const uint8_t* opcode = _bytecode.begin(); opcode < _bytecode.end(); opcode += ByteCode::length(*opcode)) {
+            if(*opcode != ByteCode::OP_NOP) {
+                positions[opcode - _bytecode.begin()] = ++position;
+            }
+        }
+        if(range.loop) {
+            lines.push_back(Line { range.begin, 1, 0 });
+            return;
+        }
+        for(auto& block : _function.basic_blocks()) {
+            if((block.begin() == block.end()) || (block.begin() < range.begin) || (block.end() > range.end)) {
+                continue;
+            }
+            if(block.origin() == BasicBlock::NO_ORIGIN) {
+                lines.push_back(Line { block.begin(), 1, 0 });
+            }
+            else {
+                lines.push_back(Line { block.begin(), file_index(ByteCode::token(_bytecode.begin() + block.origin())), positions[block.origin()] });
+            }
+        }
+    };
+
+    auto build_abbrev = [&]() -> void
+    {
+        emit_uleb(debug_abbrev, 1);
+        emit_uleb(debug_abbrev, Dwarf::TAG_COMPILE_UNIT);
+        emit_byte(debug_abbrev, Dwarf::CHILDREN_NO);
+        emit_uleb(debug_abbrev, Dwarf::AT_NAME);
+        emit_uleb(debug_abbrev, Dwarf::FORM_STRING);
+        emit_uleb(debug_abbrev, Dwarf::AT_LOW_PC);
+        emit_uleb(debug_abbrev, Dwarf::FORM_ADDR);
+        emit_uleb(debug_abbrev, Dwarf::AT_HIGH_PC);
+        emit_uleb(debug_abbrev, Dwarf::FORM_ADDR);
+        emit_uleb(debug_abbrev, Dwarf::AT_STMT_LIST);
+        emit_uleb(debug_abbrev, Dwarf::FORM_DATA4);
+        emit_uleb(debug_abbrev, 0);
+        emit_uleb(debug_abbrev, 0);
+        emit_uleb(debug_abbrev, 0);
+    };
+
+    auto build_info = [&]() -> void
+    {
+        emit_long(debug_info, 0);
+        emit_word(debug_info, Dwarf::VERSION);
+        emit_long(debug_info, 0);
+        emit_byte(debug_info, sizeof(uint64_t));
+        emit_uleb(debug_info, 1);
+        emit_string(debug_info, name);
+        emit_quad(debug_info, low_pc);
+        emit_quad(debug_info, high_pc);
+        emit_long(debug_info, 0);
+        patch_long(debug_info, 0, (debug_info.size() - 4));
+    };
+
+    auto build_line = [&]() -> void
+    {
+        static const uint8_t lengths[Dwarf::OPCODE_BASE - 1] = { 0, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1 };
+        emit_long(debug_line, 0);
+        emit_word(debug_line, Dwarf::VERSION);
+        emit_long(debug_line, 0);
+        const size_t header = debug_line.size();
+        emit_byte(debug_line, 1);
+        emit_byte(debug_line, 1);
+        emit_byte(debug_line, Dwarf::LINE_BASE);
+        emit_byte(debug_line, Dwarf::LINE_RANGE);
+        emit_byte(debug_line, Dwarf::OPCODE_BASE);
+        debug_line.insert(debug_line.end(), lengths, lengths + sizeof(lengths));
+        emit_byte(debug_line, 0);
+        for(auto& file : files) {
+            emit_string(debug_line, file);
+            emit_uleb(debug_line, 0);
+            emit_uleb(debug_line, 0);
+            emit_uleb(debug_line, 0);
+        }
+        emit_byte(debug_line, 0);
+        patch_long(debug_line, (header - 4), (debug_line.size() - header));
+        emit_byte(debug_line, 0);
+        emit_uleb(debug_line, 1 + sizeof(uint64_t));
+        emit_byte(debug_line, Dwarf::LNE_SET_ADDRESS);
+        emit_quad(debug_line, low_pc);
+        const uint8_t* address = range.begin;
+        uint32_t       file    = 1;
+        uint32_t       line    = 1;
+        for(auto& row : lines) {
+            if(row.address > address) {
+                emit_byte(debug_line, Dwarf::LNS_ADVANCE_PC);
+                emit_uleb(debug_line, (row.address - address));
+                address = row.address;
+            }
+            if(row.file != file) {
+                emit_byte(debug_line, Dwarf::LNS_SET_FILE);
+                emit_uleb(debug_line, row.file);
+                file = row.file;
+            }
+            if(row.line != line) {
+                emit_byte(debug_line, Dwarf::LNS_ADVANCE_LINE);
+                emit_sleb(debug_line, (static_cast<int64_t>(row.line) - static_cast<int64_t>(line)));
+                line = row.line;
+            }
+            emit_byte(debug_line, Dwarf::LNS_COPY);
+        }
+        if(range.end > address) {
+            emit_byte(debug_line, Dwarf::LNS_ADVANCE_PC);
+            emit_uleb(debug_line, (range.end - address));
+        }
+        emit_byte(debug_line, 0);
+        emit_uleb(debug_line, 1);
+        emit_byte(debug_line, Dwarf::LNE_END_SEQUENCE);
+        patch_long(debug_line, 0, (debug_line.size() - 4));
+    };
+
+    auto add_symbol = [&](const uint32_t st_name, const uint8_t st_info, const uint16_t st_shndx, const uint64_t st_value, const uint64_t st_size) -> size_t
+    {
+        Elf64_Sym sym;
+        ::memset(&sym, 0, sizeof(sym));
+        sym.st_name  = st_name;
+        sym.st_info  = st_info;
+        sym.st_shndx = st_shndx;
+        sym.st_value = st_value;
+        sym.st_size  = st_size;
+        symbols.push_back(sym);
+        return symbols.size() - 1;
+    };
+
+    auto add_section = [&](const uint16_t index, const char* section, const uint32_t type, const uint64_t flags, const uint64_t address, const uint64_t offset, const uint64_t size, const uint32_t link, const uint32_t info, const uint64_t alignment, const uint64_t entsize) -> void
+    {
+        Elf64_Shdr& shdr(sections[index]);
+        shdr.sh_name      = intern(shstrtab, section);
+        shdr.sh_type      = type;
+        shdr.sh_flags     = flags;
+        shdr.sh_addr      = address;
+        shdr.sh_offset    = offset;
+        shdr.sh_size      = size;
+        shdr.sh_link      = link;
+        shdr.sh_info      = info;
+        shdr.sh_addralign = alignment;
+        shdr.sh_entsize   = entsize;
+    };
+
+    build_lines();
+    build_abbrev();
+    build_info();
+    build_line();
+    ::memset(sections.data(), 0, sections.size() * sizeof(Elf64_Shdr));
+    ::memset(symbols.data(), 0, symbols.size() * sizeof(Elf64_Sym));
+    static_cast<void>(add_symbol(0, ELF64_ST_INFO(STB_LOCAL, STT_SECTION), Section::TEXT, 0, 0));
+    const size_t first = symbols.size();
+    static_cast<void>(add_symbol(intern(strtab, name), ELF64_ST_INFO(STB_GLOBAL, STT_FUNC), Section::TEXT, 0, (high_pc - low_pc)));
+
+    const size_t symtab_offset = append(symbols.data(), symbols.size() * sizeof(Elf64_Sym), 8);
+    const size_t strtab_offset = append(strtab.data(), strtab.size(), 1);
+    const size_t abbrev_offset = append(debug_abbrev.data(), debug_abbrev.size(), 1);
+    const size_t info_offset   = append(debug_info.data(), debug_info.size(), 1);
+    const size_t line_offset   = append(debug_line.data(), debug_line.size(), 1);
+    add_section(Section::TEXT, ".text", SHT_NOBITS, (SHF_ALLOC | SHF_EXECINSTR), low_pc, 0, (high_pc - low_pc), 0, 0, 16, 0);
+    add_section(Section::SYMTAB, ".symtab", SHT_SYMTAB, 0, 0, symtab_offset, symbols.size() * sizeof(Elf64_Sym), Section::STRTAB, first, 8, sizeof(Elf64_Sym));
+    add_section(Section::STRTAB, ".strtab", SHT_STRTAB, 0, 0, strtab_offset, strtab.size(), 0, 0, 1, 0);
+    add_section(Section::DEBUG_ABBREV, ".debug_abbrev", SHT_PROGBITS, 0, 0, abbrev_offset, debug_abbrev.size(), 0, 0, 1, 0);
+    add_section(Section::DEBUG_INFO, ".debug_info", SHT_PROGBITS, 0, 0, info_offset, debug_info.size(), 0, 0, 1, 0);
+    add_section(Section::DEBUG_LINE, ".debug_line", SHT_PROGBITS, 0, 0, line_offset, debug_line.size(), 0, 0, 1, 0);
+    add_section(Section::SHSTRTAB, ".shstrtab", SHT_STRTAB, 0, 0, 0, 0, 0, 0, 1, 0);
+    sections[Section::SHSTRTAB].sh_offset = append(shstrtab.data(), shstrtab.size(), 1);
+    sections[Section::SHSTRTAB].sh_size   = shstrtab.size();
+    const size_t sections_offset = append(sections.data(), sections.size() * sizeof(Elf64_Shdr), 8);
+
+    Elf64_Ehdr ehdr;
+    ::memset(&ehdr, 0, sizeof(ehdr));
+    ::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+    ehdr.e_ident[EI_CLASS]   = ELFCLASS64;
+    ehdr.e_ident[EI_DATA]    = ELFDATA2LSB;
+    ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr.e_ident[EI_OSABI]   = ELFOSABI_SYSV;
+    ehdr.e_type              = ET_REL;
+    ehdr.e_machine           = EM_X86_64;
+    ehdr.e_version           = EV_CURRENT;
+    ehdr.e_shoff             = sections_offset;
+    ehdr.e_ehsize            = sizeof(Elf64_Ehdr);
+    ehdr.e_shentsize         = sizeof(Elf64_Shdr);
+    ehdr.e_shnum             = Section::COUNT;
+    ehdr.e_shstrndx          = Section::SHSTRTAB;
+    ::memcpy(image.data(), &ehdr, sizeof(ehdr));
+
+    return image;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+/*
+ * DebugInfo.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_DebugInfo_h__
+#define __RPN_DebugInfo_h__
+
+#include "ByteCode.h"
+#include "Function.h"
+
+// ---------------------------------------------------------------------------
+// rpn::DebugInfo
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class DebugInfo
+{
+public: // public interface
+    DebugInfo(const ByteCode&, const Function&);
+
+    DebugInfo(DebugInfo&&) = delete;
+
+    DebugInfo& operator=(DebugInfo&&) = delete;
+
+    DebugInfo(const DebugInfo&) = delete;
+
+    DebugInfo& operator=(const DebugInfo&) = delete;
+
+    virtual ~DebugInfo() = default;
+
+    std::vector<std::vector<uint8_t>> images(const std::string& name) const;
+
+private: // private interface
+    struct Line
+    {
+        const uint8_t* address;
+        uint32_t       file;
+        uint32_t       line;
+    };
+
+    std::vector<uint8_t> image(const Function::Range& range, const std::string& name) const;
+
+private: // private data
+    const ByteCode& _bytecode;
+    const Function& _function;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_DebugInfo_h__ */
@@ -0,0 +1,443 @@
+/*
+ * Disassembler.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Disassembler.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Names
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Names
+{
+    static constexpr const char* R64[16] = {
+        "rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+        "r8" , "r9" , "r10", "r11", "r12", "r13", "r14", "r15",
+    };
+
+    static constexpr const char* R32[16] = {
+        "eax" , "ecx" , "edx" , "ebx" , "esp" , "ebp" , "esi" , "edi" ,
+        "r8d" , "r9d" , "r10d", "r11d", "r12d", "r13d", "r14d", "r15d",
+    };
+
+    static constexpr const char* CC[16] = {
+        "o" , "no", "b" , "ae", "e" , "ne", "be", "a" ,
+        "s" , "ns", "p" , "np", "l" , "ge", "le", "g" ,
+    };
+
+    static constexpr const char* GRP1[8] = {
+        "add", "or", "adc", "sbb", "and", "sub", "xor", "cmp",
+    };
+
+    static constexpr const char* GRP2[8] = {
+        "rol", "ror", "rcl", "rcr", "shl", "shr", "sal", "sar",
+    };
+
+    static constexpr const char* GRP3[8] = {
+        "test", nullptr, "not", "neg", "mul", "imul", "div", "idiv",
+    };
+
+    static constexpr const char* GRP5[8] = {
+        "inc", "dec", "call", nullptr, "jmp", nullptr, "push", nullptr,
+    };
+};
+
+constexpr const char* Names::R64[16];
+constexpr const char* Names::R32[16];
+constexpr const char* Names::CC[16];
+constexpr const char* Names::GRP1[8];
+constexpr const char* Names::GRP2[8];
+constexpr const char* Names::GRP3[8];
+constexpr const char* Names::GRP5[8];
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Disassembler
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Disassembler::Disassembler(const uint8_t* begin, const uint8_t* end)
+    : _current(begin)
+    , _end(end)
+{
+}
+
+bool Disassembler::next(Instruction& instruction)
+{
+    if(_current >= _end) {
+        return false;
+    }
+    if(decode(instruction) == false) {
+        instruction.address = _current;
+        instruction.length  = 1;
+        instruction.text    = "(bad)";
+    }
+    _current += instruction.length;
+    return true;
+}
+
+std::string Disassembler::format(const Instruction& instruction)
+{
+    static const char digits[] = "0123456789abcdef";
+    char              address[32];
+    std::string       bytes;
+
+    static_cast<void>(::snprintf(address, sizeof(address), "%016lx", reinterpret_cast<uintptr_t>(instruction.address)));
+    for(size_t index = 0; index < instruction.length; ++index) {
+        const uint8_t byte = instruction.address[index];
+        bytes += digits[(byte >> 4) & 0x0f];
+        bytes += digits[(byte >> 0) & 0x0f];
+        bytes += ' ';
+    }
+    bytes.resize(std::max(bytes.size(), size_t(42)), ' ');
+
+    return std::string(address) + ' ' + ' ' + bytes + instruction.text;
+}
+
+bool Disassembler::decode(Instruction& instruction) const
+{
+    const uint8_t* code   = _current;
+    size_t         size   = 0;
+    bool           valid  = true;
+    uint8_t        rex    = 0;
+    uint8_t        opcode = 0;
+    std::string    text;
+
+    auto fetch_byte = [&]() -> uint8_t
+    {
+        if((code + size) >= _end) {
+            valid = false;
+            return 0;
+        }
+        return code[size++];
+    };
+
+    auto fetch_long = [&]() -> int32_t
+    {
+        uint32_t value = 0;
+        for(int shift = 0; shift < 32; shift += 8) {
+            value |= (static_cast<uint32_t>(fetch_byte()) << shift);
+        }
+        return static_cast<int32_t>(value);
+    };
+
+    auto fetch_quad = [&]() -> uint64_t
+    {
+        uint64_t value = 0;
+        for(int shift = 0; shift < 64; shift += 8) {
+            value |= (static_cast<uint64_t>(fetch_byte()) << shift);
+        }
+        return value;
+    };
+
+    auto hex = [&](const int64_t value) -> std::string
+    {
+        char buffer[32];
+        if(value < 0) {
+            static_cast<void>(::snprintf(buffer, sizeof(buffer), "-0x%lx", static_cast<unsigned long>(-static_cast<uint64_t>(value))));
+        }
+        else {
+            static_cast<void>(::snprintf(buffer, sizeof(buffer), "0x%lx", static_cast<unsigned long>(value)));
+        }
+        return buffer;
+    };
+
+    auto uhex = [&](const uint64_t value) -> std::string
+    {
+        char buffer[32];
+        static_cast<void>(::snprintf(buffer, sizeof(buffer), "0x%lx", static_cast<unsigned long>(value)));
+        return buffer;
+    };
+
+    auto target = [&](const int32_t rel32) -> std::string
+    {
+        char buffer[32];
+        static_cast<void>(::snprintf(buffer, sizeof(buffer), "0x%lx", static_cast<unsigned long>(reinterpret_cast<uintptr_t>(code + size) + rel32)));
+        return buffer;
+    };
+
+    auto wide = [&]() -> bool
+    {
+        return (rex & 0x08) != 0;
+    };
+
+    auto reg = [&](const uint8_t index) -> std::string
+    {
+        return (wide() ? Names::R64[index & 0x0f] : Names::R32[index & 0x0f]);
+    };
+
+    auto modrm_reg = [&](const uint8_t modrm) -> std::string
+    {
+        return reg(((modrm >> 3) & 0x07) | ((rex & 0x04) << 1));
+    };
+
+    auto modrm_rm = [&](const uint8_t modrm) -> std::string
+    {
+        const uint8_t mod = ((modrm >> 6) & 0x03);
+        const uint8_t rm  = ((modrm >> 0) & 0x07);
+        std::string   base;
+        std::string   index;
+        int32_t       disp = 0;
+        if(mod == 3) {
+            return reg(rm | ((rex & 0x01) << 3));
+        }
+        if(rm == 4) {
+            const uint8_t sib   = fetch_byte();
+            const uint8_t scale = (1 << ((sib >> 6) & 0x03));
+            const uint8_t idx   = (((sib >> 3) & 0x07) | ((rex & 0x02) << 2));
+            const uint8_t bas   = (((sib >> 0) & 0x07) | ((rex & 0x01) << 3));
+            if(idx != 4) {
+                index = Names::R64[idx];
+                if(scale != 1) {
+                    index += '*' + std::to_string(scale);
+                }
+            }
+            if(((bas & 0x07) == 5) && (mod == 0)) {
+                disp = fetch_long();
+            }
+            else {
+                base = Names::R64[bas];
+            }
+        }
+        else if((rm == 5) && (mod == 0)) {
+            base = "rip";
+            disp = fetch_long();
+        }
+        else {
+            base = Names::R64[rm | ((rex & 0x01) << 3)];
+        }
+        if(mod == 1) {
+            disp = static_cast<int8_t>(fetch_byte());
+        }
+        else if(mod == 2) {
+            disp = fetch_long();
+        }
+        std::string result(wide() ? "qword ptr [" : "dword ptr [");
+        result += base;
+        if(index.empty() == false) {
+            result += (base.empty() ? "" : "+") + index;
+        }
+        if(disp != 0) {
+            result += (disp < 0 ? "" : "+") + hex(disp);
+        }
+        return result + ']';
+    };
+
+    auto alu_rm_reg = [&](const char* name) -> void
+    {
+        const uint8_t modrm = fetch_byte();
+        const std::string rm(modrm_rm(modrm));
+        text = std::string(name) + ' ' + rm + ',' + ' ' + modrm_reg(modrm);
+    };
+
+    auto alu_reg_rm = [&](const char* name) -> void
+    {
+        const uint8_t modrm = fetch_byte();
+        const std::string rm(modrm_rm(modrm));
+        text = std::string(name) + ' ' + modrm_reg(modrm) + ',' + ' ' + rm;
+    };
+
+    auto group = [&](const char* const* names, const std::string& suffix) -> void
+    {
+        const uint8_t     modrm = fetch_byte();
+        const char*       name  = names[(modrm >> 3) & 0x07];
+        const std::string rm(modrm_rm(modrm));
+        if(name == nullptr) {
+            valid = false;
+            return;
+        }
+        text = std::string(name) + ' ' + rm + suffix;
+    };
+
+    auto escape = [&]() -> void
+    {
+        const uint8_t second = fetch_byte();
+        if((second & 0xf0) == 0x80) {
+            const int32_t rel32 = fetch_long();
+            text = std::string("j") + Names::CC[second & 0x0f] + ' ' + target(rel32);
+        }
+        else if((second & 0xf0) == 0x40) {
+            alu_reg_rm((std::string("cmov") + Names::CC[second & 0x0f]).c_str());
+        }
+        else if(second == 0xaf) {
+            alu_reg_rm("imul");
+        }
+        else {
+            valid = false;
+        }
+    };
+
+    opcode = fetch_byte();
+    if((opcode & 0xf0) == 0x40) {
+        rex    = opcode;
+        opcode = fetch_byte();
+    }
+    switch(opcode) {
+        case 0x01: alu_rm_reg("add"); break;
+        case 0x09: alu_rm_reg("or");  break;
+        case 0x21: alu_rm_reg("and"); break;
+        case 0x29: alu_rm_reg("sub"); break;
+        case 0x31: alu_rm_reg("xor"); break;
+        case 0x39: alu_rm_reg("cmp"); break;
+        case 0x85: alu_rm_reg("test"); break;
+        case 0x89: alu_rm_reg("mov"); break;
+        case 0x03: alu_reg_rm("add"); break;
+        case 0x2b: alu_reg_rm("sub"); break;
+        case 0x8b: alu_reg_rm("mov"); break;
+        case 0x8d: alu_reg_rm("lea"); break;
+        case 0x0f:
+            escape();
+            break;
+        case 0x50: case 0x51: case 0x52: case 0x53:
+        case 0x54: case 0x55: case 0x56: case 0x57:
+            text = std::string("push") + ' ' + Names::R64[(opcode & 0x07) | ((rex & 0x01) << 3)];
+            break;
+        case 0x58: case 0x59: case 0x5a: case 0x5b:
+        case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+            text = std::string("pop") + ' ' + Names::R64[(opcode & 0x07) | ((rex & 0x01) << 3)];
+            break;
+        case 0x68:
+            text = std::string("push") + ' ' + hex(fetch_long());
+            break;
+        case 0x69:
+        case 0x6b:
+            {
+                const uint8_t     modrm = fetch_byte();
+                const std::string rm(modrm_rm(modrm));
+                const int32_t     imm   = (opcode == 0x6b ? static_cast<int8_t>(fetch_byte()) : fetch_long());
+                text = std::string("imul") + ' ' + modrm_reg(modrm) + ',' + ' ' + rm + ',' + ' ' + hex(imm);
+            }
+            break;
+        case 0x81:
+            {
+                const uint8_t     modrm = fetch_byte();
+                const std::string rm(modrm_rm(modrm));
+                text = std::string(Names::GRP1[(modrm >> 3) & 0x07]) + ' ' + rm + ',' + ' ' + hex(fetch_long());
+            }
+            break;
+        case 0x83:
+            {
+                const uint8_t     modrm = fetch_byte();
+                const std::string rm(modrm_rm(modrm));
+                text = std::string(Names::GRP1[(modrm >> 3) & 0x07]) + ' ' + rm + ',' + ' ' + hex(static_cast<int8_t>(fetch_byte()));
+            }
+            break;
+        case 0x90:
+            text = "nop";
+            break;
+        case 0x99:
+            text = (wide() ? "cqo" : "cdq");
+            break;
+        case 0xb8: case 0xb9: case 0xba: case 0xbb:
+        case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+            {
+                const std::string dst(reg((opcode & 0x07) | ((rex & 0x01) << 3)));
+                const uint64_t    imm = (wide() ? fetch_quad() : static_cast<uint32_t>(fetch_long()));
+                text = std::string("mov") + ' ' + dst + ',' + ' ' + uhex(imm);
+            }
+            break;
+        case 0xc1:
+            {
+                const uint8_t     modrm = fetch_byte();
+                const std::string rm(modrm_rm(modrm));
+                text = std::string(Names::GRP2[(modrm >> 3) & 0x07]) + ' ' + rm + ',' + ' ' + hex(fetch_byte());
+            }
+            break;
+        case 0xc3:
+            text = "ret";
+            break;
+        case 0xc7:
+            {
+                const uint8_t     modrm = fetch_byte();
+                const std::string rm(modrm_rm(modrm));
+                if(((modrm >> 3) & 0x07) != 0) {
+                    valid = false;
+                }
+                text = std::string("mov") + ' ' + rm + ',' + ' ' + hex(fetch_long());
+            }
+            break;
+        case 0xd3:
+            group(Names::GRP2, ", cl");
+            break;
+        case 0xe8:
+            {
+                const int32_t rel32 = fetch_long();
+                text = std::string("call") + ' ' + target(rel32);
+            }
+            break;
+        case 0xe9:
+            {
+                const int32_t rel32 = fetch_long();
+                text = std::string("jmp") + ' ' + target(rel32);
+            }
+            break;
+        case 0xf7:
+            group(Names::GRP3, "");
+            break;
+        case 0xff:
+            if(((code + size) < _end) && (code[size] == 0x25)) {
+                static_cast<void>(fetch_byte());
+                if(fetch_long() != 0) {
+                    valid = false;
+                }
+                text = std::string("jmp") + ' ' + uhex(fetch_quad());
+            }
+            else {
+                if(((code + size) < _end) && ((code[size] & 0x30) != 0x00)) {
+                    rex |= 0x08;
+                }
+                group(Names::GRP5, "");
+            }
+            break;
+        default:
+            valid = false;
+            break;
+    }
+    if(valid == false) {
+        return false;
+    }
+    instruction.address = code;
+    instruction.length  = size;
+    instruction.text    = text;
+
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,66 @@
+/*
+ * Disassembler.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Disassembler_h__
+#define __RPN_Disassembler_h__
+
+// ---------------------------------------------------------------------------
+// rpn::Disassembler
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Disassembler
+{
+public: // public interface
+    struct Instruction
+    {
+        const uint8_t* address;
+        size_t         length;
+        std::string    text;
+    };
+
+    Disassembler(const uint8_t* begin, const uint8_t* end);
+
+    Disassembler(Disassembler&&) = delete;
+
+    Disassembler& operator=(Disassembler&&) = delete;
+
+    Disassembler(const Disassembler&) = delete;
+
+    Disassembler& operator=(const Disassembler&) = delete;
+
+    virtual ~Disassembler() = default;
+
+    bool next(Instruction& instruction);
+
+    static std::string format(const Instruction& instruction);
+
+private: // private interface
+    bool decode(Instruction& instruction) const;
+
+private: // private data
+    const uint8_t* _current;
+    const uint8_t* _end;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Disassembler_h__ */
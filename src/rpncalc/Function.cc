@@ -41,6 +41,7 @@ namespace rpn {
 
 Function::Function()
     : _basic_blocks()
+    , _loop()
 {
 }
 
@@ -52,11 +53,58 @@ bool Function::callable() const
     return true;
 }
 
-void Function::execute() const
+const uint8_t* Function::begin() const
+{
+    if(_basic_blocks.empty()) {
+        return nullptr;
+    }
+    return _basic_blocks.front().begin();
+}
+
+const uint8_t* Function::end() const
+{
+    if(_basic_blocks.empty()) {
+        return nullptr;
+    }
+    return _basic_blocks.back().end();
+}
+
+const BasicBlock& Function::loop() const
+{
+    return _loop;
+}
+
+std::vector<Function::Range> Function::ranges() const
+{
+    std::vector<Range> ranges;
+
+    auto add_range = [&](const BasicBlock& block, const bool loop) -> void
+    {
+        if(block.begin() == block.end()) {
+            return;
+        }
+        if((ranges.empty() == false) && (ranges.back().end == block.begin()) && (ranges.back().loop == loop)) {
+            ranges.back().end = block.end();
+        }
+        else {
+            ranges.push_back(Range { block.begin(), block.end(), loop });
+        }
+    };
+
+    for(auto& block : _basic_blocks) {
+        add_range(block, false);
+    }
+    if(_loop.valid()) {
+        add_range(_loop, true);
+    }
+    return ranges;
+}
+
+void Function::execute(Operands& operands) const
 {
     if(_basic_blocks.size() > 0) {
         const auto& basic_block(*_basic_blocks.begin());
-        basic_block.execute();
+        basic_block.execute(operands);
     }
     else {
         throw std::runtime_error("cannot execute empty function");
@@ -64,9 +112,23 @@ void Function::execute() const
 
 }
 
+void Function::execute(Operands& operands, const uint64_t count) const
+{
+    if(count == 0) {
+        return;
+    }
+    if(_loop.valid()) {
+        _loop.execute(operands, count);
+    }
+    else for(uint64_t index = 0; index < count; ++index) {
+        execute(operands);
+    }
+}
+
 void Function::clear()
 {
     _basic_blocks.clear();
+    _loop.reset();
 }
 
 void Function::add(const BasicBlock& basic_block)
@@ -74,6 +136,17 @@ void Function::add(const BasicBlock& basic_block)
     _basic_blocks.push_back(basic_block);
 }
 
+void Function::add_loop(const BasicBlock& basic_block)
+{
+    _loop = basic_block;
+}
+
+void Function::swap(Function& function)
+{
+    std::swap(_basic_blocks, function._basic_blocks);
+    std::swap(_loop, function._loop);
+}
+
 }
 
 // ---------------------------------------------------------------------------
@@ -28,6 +28,13 @@ namespace rpn {
 class Function
 {
 public: // public interface
+    struct Range
+    {
+        const uint8_t* begin;
+        const uint8_t* end;
+        bool           loop;
+    };
+
     Function();
 
     Function(Function&&) = delete;
@@ -42,14 +49,34 @@ public: // public interface
 
     bool callable() const;
 
-    void execute() const;
+    const uint8_t* begin() const;
+
+    const uint8_t* end() const;
+
+    const BasicBlock& loop() const;
+
+    const std::vector<BasicBlock>& basic_blocks() const
+    {
+        return _basic_blocks;
+    }
+
+    std::vector<Range> ranges() const;
+
+    void execute(Operands& operands) const;
+
+    void execute(Operands& operands, const uint64_t count) const;
 
     void clear();
 
     void add(const BasicBlock& basic_block);
 
+    void add_loop(const BasicBlock& basic_block);
+
+    void swap(Function& function);
+
 private: // private data
     std::vector<BasicBlock> _basic_blocks;
+    BasicBlock              _loop;
 };
 
 }
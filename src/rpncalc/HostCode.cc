@@ -35,26 +35,234 @@
 #include <stdexcept>
 #include "HostCode.h"
 
+// ---------------------------------------------------------------------------
+// libgcc
+// ---------------------------------------------------------------------------
+
+extern "C" void __register_frame(void*);
+
+extern "C" void __deregister_frame(void*);
+
+// ---------------------------------------------------------------------------
+// gdb
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+struct jit_descriptor
+{
+    uint32_t version;
+    uint32_t action_flag;
+    void*    relevant_entry;
+    void*    first_entry;
+};
+
+enum
+{
+    JIT_NOACTION = 0,
+    JIT_REGISTER_FN,
+    JIT_UNREGISTER_FN
+};
+
+void __attribute__((noinline)) __jit_debug_register_code()
+{
+    __asm__ __volatile__("");
+}
+
+struct jit_descriptor __jit_debug_descriptor = { 1, JIT_NOACTION, nullptr, nullptr };
+
+}
+
 // ---------------------------------------------------------------------------
 // rpn::HostCode
 // ---------------------------------------------------------------------------
 
 namespace rpn {
 
+constexpr uint8_t HostCode::RAX;
+constexpr uint8_t HostCode::RCX;
+constexpr uint8_t HostCode::RDX;
+constexpr uint8_t HostCode::RBX;
+constexpr uint8_t HostCode::RSP;
+constexpr uint8_t HostCode::RBP;
+constexpr uint8_t HostCode::RSI;
+constexpr uint8_t HostCode::RDI;
+constexpr uint8_t HostCode::R8;
+constexpr uint8_t HostCode::R9;
+constexpr uint8_t HostCode::R10;
+constexpr uint8_t HostCode::R11;
+constexpr uint8_t HostCode::R12;
+constexpr uint8_t HostCode::R13;
+constexpr uint8_t HostCode::R14;
+constexpr uint8_t HostCode::R15;
+
+constexpr size_t HostCode::CHUNK_SIZE;
+constexpr size_t HostCode::CHAIN_SIZE;
+
+constexpr int HostCode::RELOC_FUNCTION;
+constexpr int HostCode::RELOC_CODE;
+
 HostCode::HostCode()
     : Buffer()
+    , _chunks()
+    , _relocations()
+    , _frames()
+    , _symfiles()
+    , _current(0)
+    , _used(0)
 {
-    Allocator::allocate(*this);
+    try {
+        _chunks.push_back(Allocator::allocate(CHUNK_SIZE));
+    }
+    catch(const std::runtime_error& e) {
+        _chunks.clear();
+    }
+    clear();
 }
 
 HostCode::~HostCode()
 {
-    Allocator::deallocate(*this);
+    remove_symfiles();
+    for(auto& frame : _frames) {
+        __deregister_frame(frame.data());
+    }
+    for(auto& chunk : _chunks) {
+        Allocator::deallocate(chunk);
+    }
 }
 
 void HostCode::clear()
 {
-    Buffer::clear(0xc3);
+    remove_symfiles();
+    for(auto& frame : _frames) {
+        __deregister_frame(frame.data());
+    }
+    _frames.clear();
+    for(auto& chunk : _chunks) {
+        std::fill(chunk.buffer, (chunk.buffer + chunk.buflen), 0xc3);
+    }
+    select(0);
+    _used = 0;
+    _relocations.clear();
+}
+
+bool HostCode::executable() const
+{
+    return _buffer != nullptr;
+}
+
+void HostCode::reserve(const size_t size)
+{
+    if(_buffer == nullptr) {
+        return;
+    }
+    if(static_cast<size_t>((_buffer + _buflen) - _bufptr) >= size) {
+        return;
+    }
+    if((_current + 1) >= _chunks.size()) {
+        _chunks.push_back(Allocator::allocate(size + CHAIN_SIZE));
+    }
+    else if(_chunks[_current + 1].buflen < (size + CHAIN_SIZE)) {
+        const Chunk chunk(Allocator::allocate(size + CHAIN_SIZE));
+        Allocator::deallocate(_chunks[_current + 1]);
+        _chunks[_current + 1] = chunk;
+    }
+    _buflen += CHAIN_SIZE;
+    jmp_imm64(reinterpret_cast<uintptr_t>(_chunks[_current + 1].buffer));
+    _used += (_bufptr - _buffer);
+    select(_current + 1);
+}
+
+size_t HostCode::used() const
+{
+    return _used + (_bufptr - _buffer);
+}
+
+size_t HostCode::capacity() const
+{
+    size_t capacity = 0;
+
+    for(auto& chunk : _chunks) {
+        capacity += chunk.buflen;
+    }
+    return capacity;
+}
+
+size_t HostCode::chunks() const
+{
+    return _chunks.size();
+}
+
+void HostCode::relocate(const int kind)
+{
+    _relocations.push_back(Relocation{(_bufptr - sizeof(uint64_t)), kind});
+}
+
+void HostCode::add_frames(const std::vector<uint8_t>& eh_frame)
+{
+    _frames.push_back(eh_frame);
+    __register_frame(_frames.back().data());
+}
+
+void HostCode::add_symfile(const std::vector<uint8_t>& image)
+{
+    _symfiles.push_back(Symfile { nullptr, nullptr, nullptr, 0, image });
+
+    Symfile& symfile(_symfiles.back());
+    Symfile* first = reinterpret_cast<Symfile*>(__jit_debug_descriptor.first_entry);
+    symfile.next_entry   = first;
+    symfile.symfile_addr = symfile.image.data();
+    symfile.symfile_size = symfile.image.size();
+    if(first != nullptr) {
+        first->prev_entry = &symfile;
+    }
+    __jit_debug_descriptor.first_entry    = &symfile;
+    __jit_debug_descriptor.relevant_entry = &symfile;
+    __jit_debug_descriptor.action_flag    = JIT_REGISTER_FN;
+    __jit_debug_register_code();
+}
+
+void HostCode::remove_symfiles()
+{
+    for(auto& symfile : _symfiles) {
+        if(symfile.prev_entry != nullptr) {
+            symfile.prev_entry->next_entry = symfile.next_entry;
+        }
+        else {
+            __jit_debug_descriptor.first_entry = symfile.next_entry;
+        }
+        if(symfile.next_entry != nullptr) {
+            symfile.next_entry->prev_entry = symfile.prev_entry;
+        }
+        __jit_debug_descriptor.relevant_entry = &symfile;
+        __jit_debug_descriptor.action_flag    = JIT_UNREGISTER_FN;
+        __jit_debug_register_code();
+    }
+    _symfiles.clear();
+}
+
+void HostCode::patch_rel32(const uint8_t* address, const uint8_t* target)
+{
+    const int64_t rel64 = (target - (address + sizeof(int32_t)));
+    const int32_t rel32 = static_cast<int32_t>(rel64);
+
+    if(rel32 != rel64) {
+        throw std::runtime_error("branch target out of range");
+    }
+    static_cast<void>(::memcpy(const_cast<uint8_t*>(address), &rel32, sizeof(rel32)));
+}
+
+void HostCode::select(const size_t index)
+{
+    if(index < _chunks.size()) {
+        _buffer = _bufptr = _chunks[index].buffer;
+        _buflen = _chunks[index].buflen - CHAIN_SIZE;
+    }
+    else {
+        _buffer = _bufptr = nullptr;
+        _buflen = 0;
+    }
+    _current = index;
 }
 
 void HostCode::emit_byte(const uint8_t value)
@@ -64,28 +272,40 @@ void HostCode::emit_byte(const uint8_t value)
 
 void HostCode::emit_word(const uint16_t value)
 {
-    Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >>  8) & 0xff));
+    const uint8_t bytes[2] = {
+        static_cast<uint8_t>((value >>  0) & 0xff),
+        static_cast<uint8_t>((value >>  8) & 0xff),
+    };
+
+    Buffer::write(bytes, sizeof(bytes));
 }
 
 void HostCode::emit_long(const uint32_t value)
 {
-    Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >>  8) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 16) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 24) & 0xff));
+    const uint8_t bytes[4] = {
+        static_cast<uint8_t>((value >>  0) & 0xff),
+        static_cast<uint8_t>((value >>  8) & 0xff),
+        static_cast<uint8_t>((value >> 16) & 0xff),
+        static_cast<uint8_t>((value >> 24) & 0xff),
+    };
+
+    Buffer::write(bytes, sizeof(bytes));
 }
 
 void HostCode::emit_quad(const uint64_t value)
 {
-    Buffer::write(static_cast<uint8_t>((value >>  0) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >>  8) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 16) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 24) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 32) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 40) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 48) & 0xff));
-    Buffer::write(static_cast<uint8_t>((value >> 56) & 0xff));
+    const uint8_t bytes[8] = {
+        static_cast<uint8_t>((value >>  0) & 0xff),
+        static_cast<uint8_t>((value >>  8) & 0xff),
+        static_cast<uint8_t>((value >> 16) & 0xff),
+        static_cast<uint8_t>((value >> 24) & 0xff),
+        static_cast<uint8_t>((value >> 32) & 0xff),
+        static_cast<uint8_t>((value >> 40) & 0xff),
+        static_cast<uint8_t>((value >> 48) & 0xff),
+        static_cast<uint8_t>((value >> 56) & 0xff),
+    };
+
+    Buffer::write(bytes, sizeof(bytes));
 }
 
 void HostCode::nop()
@@ -157,6 +377,354 @@ void HostCode::call_rax()
     emit_byte(0xd0);
 }
 
+void HostCode::jnz_rel32(const int32_t rel32)
+{
+    emit_byte(0x0f);
+    emit_byte(0x85);
+    emit_long(rel32);
+}
+
+void HostCode::jae_rel32(const int32_t rel32)
+{
+    emit_byte(0x0f);
+    emit_byte(0x83);
+    emit_long(rel32);
+}
+
+void HostCode::call_rel32(const int32_t rel32)
+{
+    emit_byte(0xe8);
+    emit_long(rel32);
+}
+
+void HostCode::jmp_rel32(const int32_t rel32)
+{
+    emit_byte(0xe9);
+    emit_long(rel32);
+}
+
+void HostCode::jmp_imm64(const uint64_t imm64)
+{
+    emit_byte(0xff);
+    emit_byte(0x25);
+    emit_long(0);
+    emit_quad(imm64);
+}
+
+void HostCode::push_r64(const uint8_t reg)
+{
+    if(reg & 0x08) {
+        emit_byte(0x41);
+    }
+    emit_byte(0x50 | (reg & 0x07));
+}
+
+void HostCode::pop_r64(const uint8_t reg)
+{
+    if(reg & 0x08) {
+        emit_byte(0x41);
+    }
+    emit_byte(0x58 | (reg & 0x07));
+}
+
+void HostCode::push_imm32(const int32_t imm32)
+{
+    emit_byte(0x68);
+    emit_long(imm32);
+}
+
+void HostCode::mov_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_alu(0x89, dst, src);
+}
+
+void HostCode::mov_r64_imm32(const uint8_t dst, const int32_t imm32)
+{
+    emit_grp(0xc7, 0, dst);
+    emit_long(imm32);
+}
+
+void HostCode::mov_r64_imm64(const uint8_t dst, const uint64_t imm64)
+{
+    emit_rex(0, dst);
+    emit_byte(0xb8 | (dst & 0x07));
+    emit_quad(imm64);
+}
+
+void HostCode::mov_r64_m64(const uint8_t dst, const uint8_t base, const int32_t disp)
+{
+    emit_rex(dst, base);
+    emit_byte(0x8b);
+    emit_modrm(dst, base, disp);
+}
+
+void HostCode::mov_m64_r64(const uint8_t base, const int32_t disp, const uint8_t src)
+{
+    emit_rex(src, base);
+    emit_byte(0x89);
+    emit_modrm(src, base, disp);
+}
+
+void HostCode::mov_m64_imm32(const uint8_t base, const int32_t disp, const int32_t imm32)
+{
+    emit_rex(0, base);
+    emit_byte(0xc7);
+    emit_modrm(0, base, disp);
+    emit_long(imm32);
+}
+
+void HostCode::add_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_alu(0x01, dst, src);
+}
+
+void HostCode::sub_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_alu(0x29, dst, src);
+}
+
+void HostCode::and_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_alu(0x21, dst, src);
+}
+
+void HostCode::or_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_alu(0x09, dst, src);
+}
+
+void HostCode::xor_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_alu(0x31, dst, src);
+}
+
+void HostCode::imul_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_rex(dst, src);
+    emit_byte(0x0f);
+    emit_byte(0xaf);
+    emit_modrm(dst, src);
+}
+
+void HostCode::cmovs_r64_r64(const uint8_t dst, const uint8_t src)
+{
+    emit_rex(dst, src);
+    emit_byte(0x0f);
+    emit_byte(0x48);
+    emit_modrm(dst, src);
+}
+
+void HostCode::add_r64_imm32(const uint8_t dst, const int32_t imm32)
+{
+    if((imm32 >= -128) && (imm32 <= 127)) {
+        emit_grp(0x83, 0, dst);
+        emit_byte(imm32);
+    }
+    else {
+        emit_grp(0x81, 0, dst);
+        emit_long(imm32);
+    }
+}
+
+void HostCode::imul_r64_imm32(const uint8_t dst, const int32_t imm32)
+{
+    if((imm32 >= -128) && (imm32 <= 127)) {
+        emit_rex(dst, dst);
+        emit_byte(0x6b);
+        emit_modrm(dst, dst);
+        emit_byte(imm32);
+    }
+    else {
+        emit_rex(dst, dst);
+        emit_byte(0x69);
+        emit_modrm(dst, dst);
+        emit_long(imm32);
+    }
+}
+
+void HostCode::and_r64_imm32(const uint8_t dst, const int32_t imm32)
+{
+    if((imm32 >= -128) && (imm32 <= 127)) {
+        emit_grp(0x83, 4, dst);
+        emit_byte(imm32);
+    }
+    else {
+        emit_grp(0x81, 4, dst);
+        emit_long(imm32);
+    }
+}
+
+void HostCode::cmp_r64_imm32(const uint8_t dst, const int32_t imm32)
+{
+    if((imm32 >= -128) && (imm32 <= 127)) {
+        emit_grp(0x83, 7, dst);
+        emit_byte(imm32);
+    }
+    else {
+        emit_grp(0x81, 7, dst);
+        emit_long(imm32);
+    }
+}
+
+void HostCode::cmp_m64_imm32(const uint8_t base, const int32_t disp, const int32_t imm32)
+{
+    emit_rex(0, base);
+    if((imm32 >= -128) && (imm32 <= 127)) {
+        emit_byte(0x83);
+        emit_modrm(7, base, disp);
+        emit_byte(imm32);
+    }
+    else {
+        emit_byte(0x81);
+        emit_modrm(7, base, disp);
+        emit_long(imm32);
+    }
+}
+
+void HostCode::lea_r64_sib(const uint8_t dst, const uint8_t base, const uint8_t index, const uint8_t scale)
+{
+    const uint8_t ss = (scale == 8 ? 3 : scale == 4 ? 2 : scale == 2 ? 1 : 0);
+
+    emit_byte(0x48 | ((dst & 0x08) >> 1) | ((index & 0x08) >> 2) | ((base & 0x08) >> 3));
+    emit_byte(0x8d);
+    if((base & 0x07) == RBP) {
+        emit_byte(0x44 | ((dst & 0x07) << 3));
+        emit_byte((ss << 6) | ((index & 0x07) << 3) | (base & 0x07));
+        emit_byte(0x00);
+    }
+    else {
+        emit_byte(0x04 | ((dst & 0x07) << 3));
+        emit_byte((ss << 6) | ((index & 0x07) << 3) | (base & 0x07));
+    }
+}
+
+void HostCode::sub_r64_imm32(const uint8_t dst, const int32_t imm32)
+{
+    if((imm32 >= -128) && (imm32 <= 127)) {
+        emit_grp(0x83, 5, dst);
+        emit_byte(imm32);
+    }
+    else {
+        emit_grp(0x81, 5, dst);
+        emit_long(imm32);
+    }
+}
+
+void HostCode::neg_r64(const uint8_t reg)
+{
+    emit_grp(0xf7, 3, reg);
+}
+
+void HostCode::not_r64(const uint8_t reg)
+{
+    emit_grp(0xf7, 2, reg);
+}
+
+void HostCode::inc_r64(const uint8_t reg)
+{
+    emit_grp(0xff, 0, reg);
+}
+
+void HostCode::dec_r64(const uint8_t reg)
+{
+    emit_grp(0xff, 1, reg);
+}
+
+void HostCode::imul_r64(const uint8_t reg)
+{
+    emit_grp(0xf7, 5, reg);
+}
+
+void HostCode::idiv_r64(const uint8_t reg)
+{
+    emit_grp(0xf7, 7, reg);
+}
+
+void HostCode::shl_r64_cl(const uint8_t reg)
+{
+    emit_grp(0xd3, 4, reg);
+}
+
+void HostCode::sar_r64_cl(const uint8_t reg)
+{
+    emit_grp(0xd3, 7, reg);
+}
+
+void HostCode::shl_r64_imm8(const uint8_t reg, const uint8_t imm8)
+{
+    emit_grp(0xc1, 4, reg);
+    emit_byte(imm8);
+}
+
+void HostCode::shr_r64_imm8(const uint8_t reg, const uint8_t imm8)
+{
+    emit_grp(0xc1, 5, reg);
+    emit_byte(imm8);
+}
+
+void HostCode::sar_r64_imm8(const uint8_t reg, const uint8_t imm8)
+{
+    emit_grp(0xc1, 7, reg);
+    emit_byte(imm8);
+}
+
+void HostCode::cqo()
+{
+    emit_byte(0x48);
+    emit_byte(0x99);
+}
+
+void HostCode::emit_rex(const uint8_t reg, const uint8_t rm)
+{
+    emit_byte(0x48 | ((reg & 0x08) >> 1) | ((rm & 0x08) >> 3));
+}
+
+void HostCode::emit_modrm(const uint8_t reg, const uint8_t rm)
+{
+    emit_byte(0xc0 | ((reg & 0x07) << 3) | (rm & 0x07));
+}
+
+void HostCode::emit_modrm(const uint8_t reg, const uint8_t base, const int32_t disp)
+{
+    const uint8_t mod_reg_rm = (((reg & 0x07) << 3) | (base & 0x07));
+
+    if((disp == 0) && ((base & 0x07) != RBP)) {
+        emit_byte(0x00 | mod_reg_rm);
+    }
+    else if((disp >= -128) && (disp <= 127)) {
+        emit_byte(0x40 | mod_reg_rm);
+    }
+    else {
+        emit_byte(0x80 | mod_reg_rm);
+    }
+    if((base & 0x07) == RSP) {
+        emit_byte(0x24);
+    }
+    if((disp == 0) && ((base & 0x07) != RBP)) {
+        return;
+    }
+    else if((disp >= -128) && (disp <= 127)) {
+        emit_byte(disp);
+    }
+    else {
+        emit_long(disp);
+    }
+}
+
+void HostCode::emit_alu(const uint8_t opcode, const uint8_t dst, const uint8_t src)
+{
+    emit_rex(src, dst);
+    emit_byte(opcode);
+    emit_modrm(src, dst);
+}
+
+void HostCode::emit_grp(const uint8_t opcode, const uint8_t ext, const uint8_t reg)
+{
+    emit_rex(0, reg);
+    emit_byte(opcode);
+    emit_modrm(ext, reg);
+}
+
 }
 
 // ---------------------------------------------------------------------------
@@ -165,52 +733,43 @@ void HostCode::call_rax()
 
 namespace rpn {
 
-void HostCode::Allocator::allocate(HostCode& hostcode)
+HostCode::Chunk HostCode::Allocator::allocate(const size_t size)
 {
-    auto& _buffer(hostcode._buffer);
-    auto& _bufptr(hostcode._bufptr);
-    auto& _buflen(hostcode._buflen);
+    Chunk chunk { nullptr, 0 };
 
-    if(_buflen == 0) {
-        const long buflen = ::sysconf(_SC_PAGESIZE);
-        if(buflen > 0) {
-            _buflen = buflen;
-        }
-        else {
-            throw std::runtime_error("sysconf() has failed");
-        }
+    const long pagesize = ::sysconf(_SC_PAGESIZE);
+    if(pagesize > 0) {
+        const size_t buflen = std::max(size, CHUNK_SIZE);
+        chunk.buflen = (((buflen + pagesize - 1) / pagesize) * pagesize);
     }
-    if(_buffer == nullptr) {
-        const int prot   = (PROT_READ | PROT_WRITE | PROT_EXEC);
-        const int flags  = (MAP_PRIVATE | MAP_ANONYMOUS);
-        void*     buffer = ::mmap(nullptr, _buflen, prot, flags, -1, 0);
-        if(buffer != MAP_FAILED) {
-            _buffer = _bufptr = reinterpret_cast<uint8_t*>(buffer);
-        }
-        else {
-            throw std::runtime_error("mmap() has failed");
-        }
+    else {
+        throw std::runtime_error("sysconf() has failed");
     }
-    hostcode.clear();
+    const int prot   = (PROT_READ | PROT_WRITE | PROT_EXEC);
+    const int flags  = (MAP_PRIVATE | MAP_ANONYMOUS);
+    void*     buffer = ::mmap(nullptr, chunk.buflen, prot, flags, -1, 0);
+    if(buffer != MAP_FAILED) {
+        chunk.buffer = reinterpret_cast<uint8_t*>(buffer);
+    }
+    else {
+        throw std::runtime_error("mmap() has failed");
+    }
+    return chunk;
 }
 
-void HostCode::Allocator::deallocate(HostCode& hostcode)
+void HostCode::Allocator::deallocate(Chunk& chunk)
 {
-    auto& _buffer(hostcode._buffer);
-    auto& _bufptr(hostcode._bufptr);
-    auto& _buflen(hostcode._buflen);
-
-    if(_buffer != nullptr) {
-        const int rc = ::munmap(_buffer, _buflen);
+    if(chunk.buffer != nullptr) {
+        const int rc = ::munmap(chunk.buffer, chunk.buflen);
         if(rc == 0) {
-            _buffer = _bufptr = nullptr;
+            chunk.buffer = nullptr;
         }
         else {
             throw std::runtime_error("munmap() has failed");
         }
     }
-    if(_buflen != 0) {
-        _buflen = 0;
+    if(chunk.buflen != 0) {
+        chunk.buflen = 0;
     }
 }
 
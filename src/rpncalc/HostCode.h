@@ -17,6 +17,7 @@
 #ifndef __RPN_HostCode_h__
 #define __RPN_HostCode_h__
 
+#include <list>
 #include "Buffer.h"
 
 // ---------------------------------------------------------------------------
@@ -29,6 +30,12 @@ class HostCode final
     : public Buffer
 {
 public: // public interface
+    struct Relocation
+    {
+        const uint8_t* address;
+        int            kind;
+    };
+
     HostCode();
 
     HostCode(HostCode&&) = delete;
@@ -43,6 +50,34 @@ public: // public interface
 
     void clear();
 
+    bool executable() const;
+
+    void reserve(const size_t size);
+
+    size_t used() const;
+
+    size_t capacity() const;
+
+    size_t chunks() const;
+
+    void relocate(const int kind);
+
+    void patch_rel32(const uint8_t* address, const uint8_t* target);
+
+    void add_frames(const std::vector<uint8_t>& eh_frame);
+
+    void add_symfile(const std::vector<uint8_t>& image);
+
+    const std::vector<Relocation>& relocations() const
+    {
+        return _relocations;
+    }
+
+    const std::list<std::vector<uint8_t>>& frames() const
+    {
+        return _frames;
+    }
+
     void emit_byte(const uint8_t value);
 
     void emit_word(const uint16_t value);
@@ -73,13 +108,154 @@ public: // public interface
 
     void call_rax();
 
+    void jnz_rel32(const int32_t rel32);
+
+    void jae_rel32(const int32_t rel32);
+
+    void call_rel32(const int32_t rel32);
+
+    void jmp_rel32(const int32_t rel32);
+
+    void jmp_imm64(const uint64_t imm64);
+
+    void push_r64(const uint8_t reg);
+
+    void pop_r64(const uint8_t reg);
+
+    void push_imm32(const int32_t imm32);
+
+    void mov_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void mov_r64_imm32(const uint8_t dst, const int32_t imm32);
+
+    void mov_r64_imm64(const uint8_t dst, const uint64_t imm64);
+
+    void mov_r64_m64(const uint8_t dst, const uint8_t base, const int32_t disp);
+
+    void mov_m64_r64(const uint8_t base, const int32_t disp, const uint8_t src);
+
+    void mov_m64_imm32(const uint8_t base, const int32_t disp, const int32_t imm32);
+
+    void add_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void sub_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void and_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void or_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void xor_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void imul_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void cmovs_r64_r64(const uint8_t dst, const uint8_t src);
+
+    void add_r64_imm32(const uint8_t dst, const int32_t imm32);
+
+    void sub_r64_imm32(const uint8_t dst, const int32_t imm32);
+
+    void imul_r64_imm32(const uint8_t dst, const int32_t imm32);
+
+    void and_r64_imm32(const uint8_t dst, const int32_t imm32);
+
+    void cmp_r64_imm32(const uint8_t dst, const int32_t imm32);
+
+    void cmp_m64_imm32(const uint8_t base, const int32_t disp, const int32_t imm32);
+
+    void lea_r64_sib(const uint8_t dst, const uint8_t base, const uint8_t index, const uint8_t scale);
+
+    void neg_r64(const uint8_t reg);
+
+    void not_r64(const uint8_t reg);
+
+    void inc_r64(const uint8_t reg);
+
+    void dec_r64(const uint8_t reg);
+
+    void imul_r64(const uint8_t reg);
+
+    void idiv_r64(const uint8_t reg);
+
+    void shl_r64_cl(const uint8_t reg);
+
+    void sar_r64_cl(const uint8_t reg);
+
+    void shl_r64_imm8(const uint8_t reg, const uint8_t imm8);
+
+    void shr_r64_imm8(const uint8_t reg, const uint8_t imm8);
+
+    void sar_r64_imm8(const uint8_t reg, const uint8_t imm8);
+
+    void cqo();
+
+public: // public static data
+    static constexpr uint8_t RAX = 0x00;
+    static constexpr uint8_t RCX = 0x01;
+    static constexpr uint8_t RDX = 0x02;
+    static constexpr uint8_t RBX = 0x03;
+    static constexpr uint8_t RSP = 0x04;
+    static constexpr uint8_t RBP = 0x05;
+    static constexpr uint8_t RSI = 0x06;
+    static constexpr uint8_t RDI = 0x07;
+    static constexpr uint8_t R8  = 0x08;
+    static constexpr uint8_t R9  = 0x09;
+    static constexpr uint8_t R10 = 0x0a;
+    static constexpr uint8_t R11 = 0x0b;
+    static constexpr uint8_t R12 = 0x0c;
+    static constexpr uint8_t R13 = 0x0d;
+    static constexpr uint8_t R14 = 0x0e;
+    static constexpr uint8_t R15 = 0x0f;
+
+    static constexpr size_t CHUNK_SIZE = 262144;
+    static constexpr size_t CHAIN_SIZE = 14;
+
+    static constexpr int RELOC_FUNCTION = 0;
+    static constexpr int RELOC_CODE     = 1;
+
 private: // private interface
+    void emit_rex(const uint8_t reg, const uint8_t rm);
+
+    void emit_modrm(const uint8_t reg, const uint8_t rm);
+
+    void emit_modrm(const uint8_t reg, const uint8_t base, const int32_t disp);
+
+    void emit_alu(const uint8_t opcode, const uint8_t dst, const uint8_t src);
+
+    void emit_grp(const uint8_t opcode, const uint8_t ext, const uint8_t reg);
+
+    struct Chunk
+    {
+        uint8_t* buffer;
+        size_t   buflen;
+    };
+
+    void select(const size_t index);
+
+    struct Symfile
+    {
+        Symfile*             next_entry;
+        Symfile*             prev_entry;
+        const uint8_t*       symfile_addr;
+        uint64_t             symfile_size;
+        std::vector<uint8_t> image;
+    };
+
+    void remove_symfiles();
+
     struct Allocator
     {
-        static void allocate(HostCode&);
+        static Chunk allocate(const size_t size);
 
-        static void deallocate(HostCode&);
+        static void deallocate(Chunk&);
     };
+
+private: // private data
+    std::vector<Chunk>              _chunks;
+    std::vector<Relocation>         _relocations;
+    std::list<std::vector<uint8_t>> _frames;
+    std::list<Symfile>              _symfiles;
+    size_t                          _current;
+    size_t                          _used;
 };
 
 }
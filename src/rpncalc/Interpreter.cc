@@ -0,0 +1,261 @@
+/*
+ * Interpreter.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Interpreter.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Interpreter
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Interpreter::Interpreter(Operands& operands, ByteCode& bytecode)
+    : _operands(operands)
+    , _bytecode(bytecode)
+    , _threads()
+{
+}
+
+void Interpreter::execute(const uint64_t count)
+{
+    static const void* const labels[] = {
+        &&op_nop,
+        &&op_i64,
+        &&op_top,
+        &&op_pop,
+        &&op_clr,
+        &&op_dup,
+        &&op_xch,
+        &&op_sto,
+        &&op_rcl,
+        &&op_abs,
+        &&op_neg,
+        &&op_add,
+        &&op_sub,
+        &&op_mul,
+        &&op_div,
+        &&op_mod,
+        &&op_cpl,
+        &&op_and,
+        &&op_ior,
+        &&op_xor,
+        &&op_shl,
+        &&op_shr,
+        &&op_inc,
+        &&op_dec,
+        &&op_hlt,
+        &&op_str,
+        &&op_rcr,
+        &&op_adi,
+        &&op_mui,
+        &&op_stk,
+        &&op_rcu,
+        &&op_dad,
+        &&op_xsb,
+        &&op_dvi,
+        &&op_mdi,
+    };
+
+    Operands&     operands(_operands);
+    const Thread* thread    = nullptr;
+    uint64_t      remaining = count;
+
+    if(remaining == 0) {
+        return;
+    }
+    _threads.clear();
+    for(const uint8_t* opcode = _bytecode.begin(); opcode < _bytecode.end(); opcode += ByteCode::length(*opcode)) {
+        if(*opcode >= (sizeof(labels) / sizeof(labels[0]))) {
+            throw std::runtime_error("unexpected opcode");
+        }
+        if(*opcode == ByteCode::OP_NOP) {
+            continue;
+        }
+        _threads.push_back(Thread { labels[*opcode], ByteCode::operand(opcode) });
+    }
+    _threads.push_back(Thread { &&op_end, 0 });
+
+    thread = _threads.data();
+    goto *thread->label;
+
+op_nop:
+    goto *(++thread)->label;
+
+op_i64:
+    static_cast<void>(Operators::op_i64(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_top:
+    static_cast<void>(Operators::op_top(operands));
+    goto *(++thread)->label;
+
+op_pop:
+    static_cast<void>(Operators::op_pop(operands));
+    goto *(++thread)->label;
+
+op_clr:
+    static_cast<void>(Operators::op_clr(operands));
+    goto *(++thread)->label;
+
+op_dup:
+    static_cast<void>(Operators::op_dup(operands));
+    goto *(++thread)->label;
+
+op_xch:
+    static_cast<void>(Operators::op_xch(operands));
+    goto *(++thread)->label;
+
+op_sto:
+    static_cast<void>(Operators::op_sto(operands));
+    goto *(++thread)->label;
+
+op_rcl:
+    static_cast<void>(Operators::op_rcl(operands));
+    goto *(++thread)->label;
+
+op_abs:
+    static_cast<void>(Operators::op_abs(operands));
+    goto *(++thread)->label;
+
+op_neg:
+    static_cast<void>(Operators::op_neg(operands));
+    goto *(++thread)->label;
+
+op_add:
+    static_cast<void>(Operators::op_add(operands));
+    goto *(++thread)->label;
+
+op_sub:
+    static_cast<void>(Operators::op_sub(operands));
+    goto *(++thread)->label;
+
+op_mul:
+    static_cast<void>(Operators::op_mul(operands));
+    goto *(++thread)->label;
+
+op_div:
+    static_cast<void>(Operators::op_div(operands));
+    goto *(++thread)->label;
+
+op_mod:
+    static_cast<void>(Operators::op_mod(operands));
+    goto *(++thread)->label;
+
+op_cpl:
+    static_cast<void>(Operators::op_cpl(operands));
+    goto *(++thread)->label;
+
+op_and:
+    static_cast<void>(Operators::op_and(operands));
+    goto *(++thread)->label;
+
+op_ior:
+    static_cast<void>(Operators::op_ior(operands));
+    goto *(++thread)->label;
+
+op_xor:
+    static_cast<void>(Operators::op_xor(operands));
+    goto *(++thread)->label;
+
+op_shl:
+    static_cast<void>(Operators::op_shl(operands));
+    goto *(++thread)->label;
+
+op_shr:
+    static_cast<void>(Operators::op_shr(operands));
+    goto *(++thread)->label;
+
+op_inc:
+    static_cast<void>(Operators::op_inc(operands));
+    goto *(++thread)->label;
+
+op_dec:
+    static_cast<void>(Operators::op_dec(operands));
+    goto *(++thread)->label;
+
+op_hlt:
+    static_cast<void>(Operators::op_hlt(operands));
+    goto *(++thread)->label;
+
+op_str:
+    static_cast<void>(Operators::op_str(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_rcr:
+    static_cast<void>(Operators::op_rcr(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_adi:
+    static_cast<void>(Operators::op_adi(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_mui:
+    static_cast<void>(Operators::op_mui(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_stk:
+    static_cast<void>(Operators::op_stk(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_rcu:
+    static_cast<void>(Operators::op_rcu(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_dad:
+    static_cast<void>(Operators::op_dad(operands));
+    goto *(++thread)->label;
+
+op_xsb:
+    static_cast<void>(Operators::op_xsb(operands));
+    goto *(++thread)->label;
+
+op_dvi:
+    static_cast<void>(Operators::op_dvi(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_mdi:
+    static_cast<void>(Operators::op_mdi(operands, thread->operand));
+    goto *(++thread)->label;
+
+op_end:
+    if(--remaining > 0) {
+        thread = _threads.data();
+        goto *thread->label;
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+/*
+ * Interpreter.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Interpreter_h__
+#define __RPN_Interpreter_h__
+
+#include "State.h"
+#include "ByteCode.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Interpreter
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Interpreter
+{
+public: // public interface
+    Interpreter(Operands&, ByteCode&);
+
+    Interpreter(Interpreter&&) = delete;
+
+    Interpreter& operator=(Interpreter&&) = delete;
+
+    Interpreter(const Interpreter&) = delete;
+
+    Interpreter& operator=(const Interpreter&) = delete;
+
+    virtual ~Interpreter() = default;
+
+    void execute(const uint64_t count);
+
+private: // private interface
+    struct Thread
+    {
+        const void* label;
+        int64_t     operand;
+    };
+
+private: // private data
+    Operands&           _operands;
+    ByteCode&           _bytecode;
+    std::vector<Thread> _threads;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Interpreter_h__ */
@@ -40,6 +40,66 @@
 
 namespace rpn {
 
+void Listener::op_str(const int64_t operand)
+{
+    op_i64(operand);
+    op_sto();
+}
+
+void Listener::op_rcr(const int64_t operand)
+{
+    op_i64(operand);
+    op_rcl();
+}
+
+void Listener::op_adi(const int64_t operand)
+{
+    op_i64(operand);
+    op_add();
+}
+
+void Listener::op_mui(const int64_t operand)
+{
+    op_i64(operand);
+    op_mul();
+}
+
+void Listener::op_stk(const int64_t operand)
+{
+    op_dup();
+    op_str(operand);
+}
+
+void Listener::op_rcu(const int64_t operand)
+{
+    op_rcr(operand);
+    op_xch();
+}
+
+void Listener::op_dad()
+{
+    op_dup();
+    op_add();
+}
+
+void Listener::op_xsb()
+{
+    op_xch();
+    op_sub();
+}
+
+void Listener::op_dvi(const int64_t operand)
+{
+    op_i64(operand);
+    op_div();
+}
+
+void Listener::op_mdi(const int64_t operand)
+{
+    op_i64(operand);
+    op_mod();
+}
+
 void Listener::op_st0()
 {
     op_i64(Registers::R00);
@@ -174,13 +234,9 @@ void Listener::op_now()
 
 void Listener::op_fib()
 {
-    op_dup();
-    op_i64(Registers::R20);
-    op_sto();
+    op_stk(Registers::R20);
     op_add();
-    op_i64(Registers::R20);
-    op_rcl();
-    op_xch();
+    op_rcu(Registers::R20);
 }
 
 void Listener::op_run()
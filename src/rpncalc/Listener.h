@@ -80,6 +80,26 @@ public: // public interface
 
     virtual void op_hlt() = 0;
 
+    virtual void op_str(const int64_t operand);
+
+    virtual void op_rcr(const int64_t operand);
+
+    virtual void op_adi(const int64_t operand);
+
+    virtual void op_mui(const int64_t operand);
+
+    virtual void op_stk(const int64_t operand);
+
+    virtual void op_rcu(const int64_t operand);
+
+    virtual void op_dad();
+
+    virtual void op_xsb();
+
+    virtual void op_dvi(const int64_t operand);
+
+    virtual void op_mdi(const int64_t operand);
+
     virtual void op_st0();
 
     virtual void op_st1();
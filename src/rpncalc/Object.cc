@@ -0,0 +1,265 @@
+/*
+ * Object.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <elf.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Object.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Section
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Section
+{
+    static constexpr uint16_t NUL      = 0;
+    static constexpr uint16_t TEXT     = 1;
+    static constexpr uint16_t SYMTAB   = 2;
+    static constexpr uint16_t STRTAB   = 3;
+    static constexpr uint16_t RELA     = 4;
+    static constexpr uint16_t SHSTRTAB = 5;
+    static constexpr uint16_t STACK    = 6;
+    static constexpr uint16_t COUNT    = 7;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Object
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Object::Object(HostCode& hostcode, Function& function)
+    : _hostcode(hostcode)
+    , _function(function)
+{
+}
+
+void Object::write(const std::string& symbol, const std::string& filename)
+{
+    if(_function.callable() == false) {
+        throw std::runtime_error("cannot export an empty function");
+    }
+    _hostcode.reserve(64);
+    const uint8_t* entry = _hostcode.end();
+    _hostcode.push_r64(HostCode::RBX);
+    _hostcode.mov_r64_r64(HostCode::RBX, HostCode::RDI);
+    _hostcode.call_rel32(_function.begin() - (_hostcode.end() + 5));
+    _hostcode.xor_r64_r64(HostCode::RAX, HostCode::RAX);
+    _hostcode.cmp_m64_imm32(HostCode::RBX, offsetof(Operands, status), Operands::STATUS_OK);
+    _hostcode.jnz_rel32(15);
+    _hostcode.mov_r64_r64(HostCode::RDI, HostCode::RBX);
+    _hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(&Checked::op_top));
+    _hostcode.relocate(HostCode::RELOC_FUNCTION);
+    _hostcode.call_rax();
+    _hostcode.pop_r64(HostCode::RBX);
+    _hostcode.ret();
+
+    const uint8_t* base = _hostcode.begin();
+    const size_t   size = _hostcode.end() - _hostcode.begin();
+    if(_hostcode.used() != size) {
+        throw std::runtime_error("cannot export a function spanning several code chunks");
+    }
+    std::vector<uint8_t>    text(base, base + size);
+    std::vector<Relocation> relocations;
+
+    link(text, relocations);
+
+    return emit(symbol, filename, text, relocations, (entry - base));
+}
+
+void Object::link(std::vector<uint8_t>& text, std::vector<Relocation>& relocations)
+{
+    const uint8_t* base = _hostcode.begin();
+
+    auto rewrite = [&](const size_t offset, const uint8_t opcode, const uint8_t modrm, const int32_t disp) -> void
+    {
+        text[offset + 0] = 0x48;
+        text[offset + 1] = opcode;
+        text[offset + 2] = modrm;
+        ::memcpy(&text[offset + 3], &disp, sizeof(disp));
+        text[offset + 7] = 0x0f;
+        text[offset + 8] = 0x1f;
+        text[offset + 9] = 0x00;
+    };
+
+    for(auto& relocation : _hostcode.relocations()) {
+        const size_t offset = (relocation.address - base) - 2;
+        uint64_t     value  = 0;
+        uint32_t     index  = 0;
+        if((relocation.address < (base + 2)) || ((offset + 10) > text.size())) {
+            throw std::runtime_error("invalid relocation");
+        }
+        ::memcpy(&value, &text[offset + 2], sizeof(value));
+        switch(relocation.kind) {
+            case HostCode::RELOC_FUNCTION:
+                if((text[offset + 0] != 0x48) || (text[offset + 1] != 0xb8) || (Symbols::find(value, index) == false)) {
+                    throw std::runtime_error("unexpected function relocation");
+                }
+                rewrite(offset, 0x8d, 0x05, 0);
+                relocations.push_back(Relocation{(offset + 3), R_X86_64_PC32, Symbols::table()[index].name, -4});
+                break;
+            case HostCode::RELOC_CODE:
+                if((text[offset + 0] != 0x48) || (text[offset + 1] != 0xb8)) {
+                    throw std::runtime_error("unexpected code relocation");
+                }
+                rewrite(offset, 0x8d, 0x05, static_cast<int32_t>((reinterpret_cast<const uint8_t*>(value) - base) - (offset + 7)));
+                break;
+            default:
+                throw std::runtime_error("invalid relocation");
+        }
+    }
+}
+
+void Object::emit(const std::string& symbol, const std::string& filename, const std::vector<uint8_t>& text, const std::vector<Relocation>& relocations, const size_t entry)
+{
+    std::vector<uint8_t>          image(sizeof(Elf64_Ehdr));
+    std::vector<Elf64_Shdr>       sections(Section::COUNT);
+    std::vector<Elf64_Sym>        symbols(1);
+    std::vector<Elf64_Rela>       relas;
+    std::map<std::string, size_t> externs;
+    std::string                   strtab(1, '\0');
+    std::string                   shstrtab(1, '\0');
+
+    auto append = [&](const void* data, const size_t size, const size_t alignment) -> size_t
+    {
+        while((image.size() % alignment) != 0) {
+            image.push_back(0);
+        }
+        const size_t   offset = image.size();
+        const uint8_t* bytes  = reinterpret_cast<const uint8_t*>(data);
+        image.insert(image.end(), bytes, bytes + size);
+        return offset;
+    };
+
+    auto name = [&](std::string& table, const std::string& string) -> uint32_t
+    {
+        const uint32_t offset = table.size();
+        table += string;
+        table += '\0';
+        return offset;
+    };
+
+    auto add_symbol = [&](const uint32_t st_name, const uint8_t st_info, const uint16_t st_shndx, const uint64_t st_value, const uint64_t st_size) -> size_t
+    {
+        Elf64_Sym sym;
+        ::memset(&sym, 0, sizeof(sym));
+        sym.st_name  = st_name;
+        sym.st_info  = st_info;
+        sym.st_shndx = st_shndx;
+        sym.st_value = st_value;
+        sym.st_size  = st_size;
+        symbols.push_back(sym);
+        return symbols.size() - 1;
+    };
+
+    auto add_section = [&](const uint16_t index, const char* section, const uint32_t type, const uint64_t flags, const uint64_t offset, const uint64_t size, const uint32_t link, const uint32_t info, const uint64_t alignment, const uint64_t entsize) -> void
+    {
+        Elf64_Shdr& shdr(sections[index]);
+        shdr.sh_name      = name(shstrtab, section);
+        shdr.sh_type      = type;
+        shdr.sh_flags     = flags;
+        shdr.sh_addr      = 0;
+        shdr.sh_offset    = offset;
+        shdr.sh_size      = size;
+        shdr.sh_link      = link;
+        shdr.sh_info      = info;
+        shdr.sh_addralign = alignment;
+        shdr.sh_entsize   = entsize;
+    };
+
+    ::memset(sections.data(), 0, sections.size() * sizeof(Elf64_Shdr));
+    ::memset(symbols.data(), 0, symbols.size() * sizeof(Elf64_Sym));
+    static_cast<void>(add_symbol(0, ELF64_ST_INFO(STB_LOCAL, STT_SECTION), Section::TEXT, 0, 0));
+    const size_t first = symbols.size();
+    static_cast<void>(add_symbol(name(strtab, symbol), ELF64_ST_INFO(STB_GLOBAL, STT_FUNC), Section::TEXT, entry, (text.size() - entry)));
+    for(auto& relocation : relocations) {
+        auto found = externs.find(relocation.symbol);
+        if(found == externs.end()) {
+            found = externs.emplace(relocation.symbol, add_symbol(name(strtab, relocation.symbol), ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE), SHN_UNDEF, 0, 0)).first;
+        }
+        const size_t index = found->second;
+        Elf64_Rela rela;
+        rela.r_offset = relocation.offset;
+        rela.r_info   = ELF64_R_INFO(index, relocation.type);
+        rela.r_addend = relocation.addend;
+        relas.push_back(rela);
+    }
+
+    const size_t text_offset   = append(text.data(), text.size(), 16);
+    const size_t symtab_offset = append(symbols.data(), symbols.size() * sizeof(Elf64_Sym), 8);
+    const size_t strtab_offset = append(strtab.data(), strtab.size(), 1);
+    const size_t rela_offset   = append(relas.data(), relas.size() * sizeof(Elf64_Rela), 8);
+    add_section(Section::TEXT, ".text", SHT_PROGBITS, (SHF_ALLOC | SHF_EXECINSTR), text_offset, text.size(), 0, 0, 16, 0);
+    add_section(Section::SYMTAB, ".symtab", SHT_SYMTAB, 0, symtab_offset, symbols.size() * sizeof(Elf64_Sym), Section::STRTAB, first, 8, sizeof(Elf64_Sym));
+    add_section(Section::STRTAB, ".strtab", SHT_STRTAB, 0, strtab_offset, strtab.size(), 0, 0, 1, 0);
+    add_section(Section::RELA, ".rela.text", SHT_RELA, SHF_INFO_LINK, rela_offset, relas.size() * sizeof(Elf64_Rela), Section::SYMTAB, Section::TEXT, 8, sizeof(Elf64_Rela));
+    add_section(Section::STACK, ".note.GNU-stack", SHT_PROGBITS, 0, image.size(), 0, 0, 0, 1, 0);
+    add_section(Section::SHSTRTAB, ".shstrtab", SHT_STRTAB, 0, 0, 0, 0, 0, 1, 0);
+    sections[Section::SHSTRTAB].sh_offset = append(shstrtab.data(), shstrtab.size(), 1);
+    sections[Section::SHSTRTAB].sh_size   = shstrtab.size();
+    const size_t sections_offset = append(sections.data(), sections.size() * sizeof(Elf64_Shdr), 8);
+
+    Elf64_Ehdr ehdr;
+    ::memset(&ehdr, 0, sizeof(ehdr));
+    ::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+    ehdr.e_ident[EI_CLASS]   = ELFCLASS64;
+    ehdr.e_ident[EI_DATA]    = ELFDATA2LSB;
+    ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr.e_ident[EI_OSABI]   = ELFOSABI_SYSV;
+    ehdr.e_type              = ET_REL;
+    ehdr.e_machine           = EM_X86_64;
+    ehdr.e_version           = EV_CURRENT;
+    ehdr.e_shoff             = sections_offset;
+    ehdr.e_ehsize            = sizeof(Elf64_Ehdr);
+    ehdr.e_shentsize         = sizeof(Elf64_Shdr);
+    ehdr.e_shnum             = Section::COUNT;
+    ehdr.e_shstrndx          = Section::SHSTRTAB;
+    ::memcpy(image.data(), &ehdr, sizeof(ehdr));
+
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(image.data()), image.size());
+    stream.close();
+    if(stream.fail()) {
+        throw std::runtime_error(std::string("unable to write") + ' ' + '<' + filename + '>');
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,71 @@
+/*
+ * Object.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Object_h__
+#define __RPN_Object_h__
+
+#include "State.h"
+#include "HostCode.h"
+#include "Function.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Object
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Object
+{
+public: // public interface
+    Object(HostCode&, Function&);
+
+    Object(Object&&) = delete;
+
+    Object& operator=(Object&&) = delete;
+
+    Object(const Object&) = delete;
+
+    Object& operator=(const Object&) = delete;
+
+    virtual ~Object() = default;
+
+    void write(const std::string& symbol, const std::string& filename);
+
+private: // private interface
+    struct Relocation
+    {
+        uint64_t    offset;
+        uint32_t    type;
+        std::string symbol;
+        int64_t     addend;
+    };
+
+    void link(std::vector<uint8_t>& text, std::vector<Relocation>& relocations);
+
+    void emit(const std::string& symbol, const std::string& filename, const std::vector<uint8_t>& text, const std::vector<Relocation>& relocations, const size_t entry);
+
+private: // private data
+    HostCode& _hostcode;
+    Function& _function;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Object_h__ */
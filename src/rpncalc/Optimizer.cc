@@ -0,0 +1,474 @@
+/*
+ * Optimizer.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "State.h"
+#include "Optimizer.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Arithmetic
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Arithmetic
+{
+    static bool unary(const uint8_t opcode, const int64_t op1, int64_t& res)
+    {
+        const uint64_t op1u = static_cast<uint64_t>(op1);
+
+        switch(opcode) {
+            case rpn::ByteCode::OP_ABS:
+                res = static_cast<int64_t>(op1 < 0 ? (0 - op1u) : op1u);
+                return true;
+            case rpn::ByteCode::OP_NEG:
+                res = static_cast<int64_t>(0 - op1u);
+                return true;
+            case rpn::ByteCode::OP_CPL:
+                res = static_cast<int64_t>(~op1u);
+                return true;
+            case rpn::ByteCode::OP_INC:
+                res = static_cast<int64_t>(op1u + 1);
+                return true;
+            case rpn::ByteCode::OP_DEC:
+                res = static_cast<int64_t>(op1u - 1);
+                return true;
+            default:
+                break;
+        }
+        return false;
+    }
+
+    static bool binary(const uint8_t opcode, const int64_t op1, const int64_t op2, int64_t& res)
+    {
+        const uint64_t op1u = static_cast<uint64_t>(op1);
+        const uint64_t op2u = static_cast<uint64_t>(op2);
+
+        auto divisible = [&]() -> bool
+        {
+            if(op2 == 0) {
+                return false;
+            }
+            if((op1 == INT64_MIN) && (op2 == -1)) {
+                return false;
+            }
+            return true;
+        };
+
+        auto shiftable = [&]() -> bool
+        {
+            return ((op2 >= 0) && (op2 < 64));
+        };
+
+        switch(opcode) {
+            case rpn::ByteCode::OP_ADD:
+                res = static_cast<int64_t>(op1u + op2u);
+                return true;
+            case rpn::ByteCode::OP_SUB:
+                res = static_cast<int64_t>(op1u - op2u);
+                return true;
+            case rpn::ByteCode::OP_MUL:
+                res = static_cast<int64_t>(op1u * op2u);
+                return true;
+            case rpn::ByteCode::OP_DIV:
+                if(divisible()) {
+                    res = (op1 / op2);
+                    return true;
+                }
+                break;
+            case rpn::ByteCode::OP_MOD:
+                if(divisible()) {
+                    res = (op1 % op2);
+                    return true;
+                }
+                break;
+            case rpn::ByteCode::OP_AND:
+                res = (op1 & op2);
+                return true;
+            case rpn::ByteCode::OP_IOR:
+                res = (op1 | op2);
+                return true;
+            case rpn::ByteCode::OP_XOR:
+                res = (op1 ^ op2);
+                return true;
+            case rpn::ByteCode::OP_SHL:
+                if(shiftable()) {
+                    res = static_cast<int64_t>(op1u << op2);
+                    return true;
+                }
+                break;
+            case rpn::ByteCode::OP_SHR:
+                if(shiftable()) {
+                    res = (op1 >> op2);
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+        return false;
+    }
+
+    static bool identity(const uint8_t opcode, const int64_t op2)
+    {
+        switch(opcode) {
+            case rpn::ByteCode::OP_ADD:
+            case rpn::ByteCode::OP_SUB:
+            case rpn::ByteCode::OP_IOR:
+            case rpn::ByteCode::OP_XOR:
+            case rpn::ByteCode::OP_SHL:
+            case rpn::ByteCode::OP_SHR:
+                return (op2 == 0);
+            case rpn::ByteCode::OP_MUL:
+            case rpn::ByteCode::OP_DIV:
+                return (op2 == 1);
+            case rpn::ByteCode::OP_AND:
+                return (op2 == -1);
+            default:
+                break;
+        }
+        return false;
+    }
+
+    static bool divisor(const int64_t op2)
+    {
+        if((op2 >= -1) && (op2 <= 1)) {
+            return false;
+        }
+        if(op2 == INT64_MIN) {
+            return false;
+        }
+        return true;
+    }
+
+    static bool produces(const uint8_t opcode)
+    {
+        switch(opcode) {
+            case rpn::ByteCode::OP_NOP:
+            case rpn::ByteCode::OP_POP:
+            case rpn::ByteCode::OP_CLR:
+            case rpn::ByteCode::OP_STO:
+            case rpn::ByteCode::OP_HLT:
+            case rpn::ByteCode::OP_STR:
+                return false;
+            default:
+                break;
+        }
+        return true;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Optimizer
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Optimizer::Optimizer(ByteCode& bytecode)
+    : _bytecode(bytecode)
+    , _input()
+    , _output()
+{
+}
+
+void Optimizer::optimize()
+{
+    decode();
+    for(auto& instruction : _input) {
+        append(instruction);
+    }
+    peephole();
+    encode();
+}
+
+void Optimizer::decode()
+{
+    _input.clear();
+    _output.clear();
+    for(const uint8_t* opcode = _bytecode.begin(); opcode < _bytecode.end(); opcode += ByteCode::length(*opcode)) {
+        _input.push_back(Instruction { *opcode, ByteCode::operand(opcode) });
+    }
+}
+
+void Optimizer::encode()
+{
+    _bytecode.clear();
+    for(auto& instruction : _output) {
+        switch(instruction.opcode) {
+            case ByteCode::OP_I64:
+                _bytecode.emit_i64(instruction.operand);
+                break;
+            case ByteCode::OP_STR:
+                _bytecode.emit_str(instruction.operand);
+                break;
+            case ByteCode::OP_RCR:
+                _bytecode.emit_rcr(instruction.operand);
+                break;
+            case ByteCode::OP_ADI:
+                _bytecode.emit_adi(instruction.operand);
+                break;
+            case ByteCode::OP_MUI:
+                _bytecode.emit_mui(instruction.operand);
+                break;
+            case ByteCode::OP_STK:
+                _bytecode.emit_stk(instruction.operand);
+                break;
+            case ByteCode::OP_RCU:
+                _bytecode.emit_rcu(instruction.operand);
+                break;
+            case ByteCode::OP_DVI:
+                _bytecode.emit_dvi(instruction.operand);
+                break;
+            case ByteCode::OP_MDI:
+                _bytecode.emit_mdi(instruction.operand);
+                break;
+            default:
+                _bytecode.emit_byte(instruction.opcode);
+                break;
+        }
+    }
+}
+
+void Optimizer::append(const Instruction& instruction)
+{
+    if(fold_unary(instruction)) {
+        return;
+    }
+    if(fold_binary(instruction)) {
+        return;
+    }
+    if(simplify(instruction)) {
+        return;
+    }
+    if(collapse(instruction)) {
+        return;
+    }
+    _output.push_back(instruction);
+}
+
+bool Optimizer::fold_unary(const Instruction& instruction)
+{
+    const size_t count = _output.size();
+
+    if(count >= 1) {
+        Instruction& op1(_output[count - 1]);
+        int64_t      res(0);
+        if((op1.opcode == ByteCode::OP_I64) && Arithmetic::unary(instruction.opcode, op1.operand, res)) {
+            op1.operand = res;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Optimizer::fold_binary(const Instruction& instruction)
+{
+    const size_t count = _output.size();
+
+    if(count >= 2) {
+        Instruction& op1(_output[count - 2]);
+        Instruction& op2(_output[count - 1]);
+        int64_t      res(0);
+        if((op1.opcode == ByteCode::OP_I64) && (op2.opcode == ByteCode::OP_I64) && Arithmetic::binary(instruction.opcode, op1.operand, op2.operand, res)) {
+            op1.operand = res;
+            _output.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Optimizer::simplify(const Instruction& instruction)
+{
+    const size_t count = _output.size();
+    const uint8_t last = (count >= 1 ? _output[count - 1].opcode : ByteCode::OP_NOP);
+
+    switch(instruction.opcode) {
+        case ByteCode::OP_NOP:
+            return true;
+        case ByteCode::OP_TOP:
+            if((count >= 1) && Arithmetic::produces(last)) {
+                return true;
+            }
+            break;
+        case ByteCode::OP_POP:
+            if(last == ByteCode::OP_I64) {
+                _output.pop_back();
+                return true;
+            }
+            if(last == ByteCode::OP_DUP) {
+                _output.pop_back();
+                append(Instruction { ByteCode::OP_TOP, 0 });
+                return true;
+            }
+            break;
+        case ByteCode::OP_XCH:
+            if(last == ByteCode::OP_DUP) {
+                return true;
+            }
+            break;
+        default:
+            if((last == ByteCode::OP_I64) && Arithmetic::identity(instruction.opcode, _output[count - 1].operand)) {
+                _output.pop_back();
+                append(Instruction { ByteCode::OP_TOP, 0 });
+                return true;
+            }
+            break;
+    }
+    return false;
+}
+
+bool Optimizer::collapse(const Instruction& instruction)
+{
+    const size_t count = _output.size();
+
+    if(count >= 1) {
+        Instruction& op1(_output[count - 1]);
+        if((op1.opcode == ByteCode::OP_I64) && (op1.operand >= Registers::R00) && (op1.operand <= Registers::R31)) {
+            switch(instruction.opcode) {
+                case ByteCode::OP_STO:
+                    op1.opcode = ByteCode::OP_STR;
+                    return true;
+                case ByteCode::OP_RCL:
+                    op1.opcode = ByteCode::OP_RCR;
+                    return true;
+                default:
+                    break;
+            }
+        }
+    }
+    return false;
+}
+
+void Optimizer::peephole()
+{
+    std::vector<Instruction> input;
+
+    input.swap(_output);
+    for(auto& instruction : input) {
+        if(fuse(instruction) == false) {
+            _output.push_back(instruction);
+        }
+    }
+}
+
+bool Optimizer::fuse(const Instruction& instruction)
+{
+    const size_t count = _output.size();
+
+    auto merge = [&](const uint8_t opcode, const int64_t operand) -> bool
+    {
+        Instruction& op1(_output[count - 1]);
+        if((count >= 2) && (_output[count - 2].opcode == opcode)) {
+            Instruction& op0(_output[count - 2]);
+            int64_t      res(0);
+            if(opcode == ByteCode::OP_ADI) {
+                static_cast<void>(Arithmetic::binary(ByteCode::OP_ADD, op0.operand, operand, res));
+            }
+            else {
+                static_cast<void>(Arithmetic::binary(ByteCode::OP_MUL, op0.operand, operand, res));
+            }
+            op0.operand = res;
+            _output.pop_back();
+        }
+        else {
+            op1.opcode  = opcode;
+            op1.operand = operand;
+        }
+        return true;
+    };
+
+    if(count >= 1) {
+        Instruction& op1(_output[count - 1]);
+        switch(instruction.opcode) {
+            case ByteCode::OP_ADD:
+                if(op1.opcode == ByteCode::OP_I64) {
+                    return merge(ByteCode::OP_ADI, op1.operand);
+                }
+                if(op1.opcode == ByteCode::OP_DUP) {
+                    op1.opcode = ByteCode::OP_DAD;
+                    return true;
+                }
+                break;
+            case ByteCode::OP_SUB:
+                if((op1.opcode == ByteCode::OP_I64) && (op1.operand != INT64_MIN)) {
+                    return merge(ByteCode::OP_ADI, -op1.operand);
+                }
+                if(op1.opcode == ByteCode::OP_XCH) {
+                    op1.opcode = ByteCode::OP_XSB;
+                    return true;
+                }
+                break;
+            case ByteCode::OP_MUL:
+                if(op1.opcode == ByteCode::OP_I64) {
+                    return merge(ByteCode::OP_MUI, op1.operand);
+                }
+                break;
+            case ByteCode::OP_DIV:
+                if((op1.opcode == ByteCode::OP_I64) && Arithmetic::divisor(op1.operand)) {
+                    op1.opcode = ByteCode::OP_DVI;
+                    return true;
+                }
+                break;
+            case ByteCode::OP_MOD:
+                if((op1.opcode == ByteCode::OP_I64) && Arithmetic::divisor(op1.operand)) {
+                    op1.opcode = ByteCode::OP_MDI;
+                    return true;
+                }
+                break;
+            case ByteCode::OP_STR:
+                if(op1.opcode == ByteCode::OP_DUP) {
+                    op1.opcode  = ByteCode::OP_STK;
+                    op1.operand = instruction.operand;
+                    return true;
+                }
+                break;
+            case ByteCode::OP_XCH:
+                if(op1.opcode == ByteCode::OP_RCR) {
+                    op1.opcode = ByteCode::OP_RCU;
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+/*
+ * Optimizer.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Optimizer_h__
+#define __RPN_Optimizer_h__
+
+#include "ByteCode.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Optimizer
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Optimizer
+{
+public: // public interface
+    Optimizer(ByteCode&);
+
+    Optimizer(Optimizer&&) = delete;
+
+    Optimizer& operator=(Optimizer&&) = delete;
+
+    Optimizer(const Optimizer&) = delete;
+
+    Optimizer& operator=(const Optimizer&) = delete;
+
+    virtual ~Optimizer() = default;
+
+    void optimize();
+
+private: // private interface
+    struct Instruction
+    {
+        uint8_t opcode;
+        int64_t operand;
+    };
+
+    void decode();
+
+    void encode();
+
+    void append(const Instruction& instruction);
+
+    bool fold_unary(const Instruction& instruction);
+
+    bool fold_binary(const Instruction& instruction);
+
+    bool simplify(const Instruction& instruction);
+
+    bool collapse(const Instruction& instruction);
+
+    void peephole();
+
+    bool fuse(const Instruction& instruction);
+
+private: // private data
+    ByteCode&                _bytecode;
+    std::vector<Instruction> _input;
+    std::vector<Instruction> _output;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Optimizer_h__ */
@@ -0,0 +1,317 @@
+/*
+ * Profiler.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+#include <elf.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Profiler.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Profiler
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+constexpr uint32_t Profiler::JITDUMP_MAGIC;
+constexpr uint32_t Profiler::JITDUMP_VERSION;
+constexpr uint32_t Profiler::JIT_CODE_LOAD;
+constexpr uint32_t Profiler::JIT_CODE_DEBUG_INFO;
+constexpr uint32_t Profiler::JIT_CODE_CLOSE;
+constexpr size_t   Profiler::LABEL_LENGTH;
+
+Profiler::Profiler()
+    : _perf_map(-1)
+    , _jitdump(-1)
+    , _marker(MAP_FAILED)
+    , _marker_size(0)
+    , _index(0)
+{
+}
+
+Profiler::~Profiler()
+{
+    if(_jitdump >= 0) {
+        std::vector<uint8_t> record;
+        const uint64_t       now = timestamp();
+        for(int shift = 0; shift < 32; shift += 8) {
+            record.push_back(JIT_CODE_CLOSE >> shift);
+        }
+        for(int shift = 0; shift < 32; shift += 8) {
+            record.push_back(16 >> shift);
+        }
+        for(int shift = 0; shift < 64; shift += 8) {
+            record.push_back(now >> shift);
+        }
+        write(_jitdump, record);
+    }
+    if(_marker != MAP_FAILED) {
+        static_cast<void>(::munmap(_marker, _marker_size));
+        _marker = MAP_FAILED;
+    }
+    if(_jitdump >= 0) {
+        static_cast<void>(::close(_jitdump));
+        _jitdump = -1;
+    }
+    if(_perf_map >= 0) {
+        static_cast<void>(::close(_perf_map));
+        _perf_map = -1;
+    }
+}
+
+void Profiler::open_perf_map()
+{
+    const std::string filename(std::string("/tmp/perf-") + std::to_string(::getpid()) + ".map");
+
+    if(_perf_map >= 0) {
+        return;
+    }
+    _perf_map = ::open(filename.c_str(), (O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC), 0644);
+    if(_perf_map < 0) {
+        throw std::runtime_error(std::string("unable to open the perf map") + ' ' + '<' + filename + '>');
+    }
+}
+
+void Profiler::open_jitdump()
+{
+    const std::string filename(std::string("jit-") + std::to_string(::getpid()) + ".dump");
+    std::vector<uint8_t> header;
+
+    auto emit_long = [&](const uint32_t value) -> void
+    {
+        for(int shift = 0; shift < 32; shift += 8) {
+            header.push_back(value >> shift);
+        }
+    };
+
+    auto emit_quad = [&](const uint64_t value) -> void
+    {
+        for(int shift = 0; shift < 64; shift += 8) {
+            header.push_back(value >> shift);
+        }
+    };
+
+    if(_jitdump >= 0) {
+        return;
+    }
+    _jitdump = ::open(filename.c_str(), (O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC), 0644);
+    if(_jitdump < 0) {
+        throw std::runtime_error(std::string("unable to open the jitdump") + ' ' + '<' + filename + '>');
+    }
+    emit_long(JITDUMP_MAGIC);
+    emit_long(JITDUMP_VERSION);
+    emit_long(40);
+    emit_long(EM_X86_64);
+    emit_long(0);
+    emit_long(::getpid());
+    emit_quad(timestamp());
+    emit_quad(0);
+    write(_jitdump, header);
+    _marker_size = ::sysconf(_SC_PAGESIZE);
+    _marker      = ::mmap(nullptr, _marker_size, (PROT_READ | PROT_EXEC), MAP_PRIVATE, _jitdump, 0);
+    if(_marker == MAP_FAILED) {
+        throw std::runtime_error(std::string("unable to map the jitdump") + ' ' + '<' + filename + '>');
+    }
+}
+
+void Profiler::load(const std::string& name, const ByteCode& bytecode, const Function& function)
+{
+    if((enabled() == false) || (function.callable() == false)) {
+        return;
+    }
+    for(auto& range : function.ranges()) {
+        const std::string symbol(range.loop ? name + ".loop" : name);
+        if(_perf_map >= 0) {
+            write_perf_map(range, symbol);
+        }
+        if(_jitdump >= 0) {
+            write_jitdump(range, symbol, bytecode, function);
+        }
+    }
+}
+
+std::string Profiler::label(const ByteCode& bytecode)
+{
+    std::string result;
+
+    for(const uint8_t* opcode = bytecode.begin(); opcode < bytecode.end(); opcode += ByteCode::length(*opcode)) {
+        if(*opcode == ByteCode::OP_NOP) {
+            continue;
+        }
+        if(result.empty() == false) {
+            result += ' ';
+        }
+        result += ByteCode::token(opcode);
+    }
+    if(result.size() > LABEL_LENGTH) {
+        result.resize(LABEL_LENGTH - 3);
+        result += "...";
+    }
+    return std::string("rpn") + '[' + result + ']';
+}
+
+void Profiler::write_perf_map(const Function::Range& range, const std::string& name)
+{
+    char buffer[64];
+
+    const int length = ::snprintf(buffer, sizeof(buffer), "%lx %lx ", reinterpret_cast<uintptr_t>(range.begin), static_cast<unsigned long>(range.end - range.begin));
+    const std::string line(std::string(buffer, length) + name + '\n');
+
+    write(_perf_map, std::vector<uint8_t>(line.begin(), line.end()));
+}
+
+void Profiler::write_jitdump(const Function::Range& range, const std::string& name, const ByteCode& bytecode, const Function& function)
+{
+    std::vector<uint8_t> record;
+
+    auto emit_byte = [&](const uint8_t value) -> void
+    {
+        record.push_back(value);
+    };
+
+    auto emit_long = [&](const uint32_t value) -> void
+    {
+        for(int shift = 0; shift < 32; shift += 8) {
+            emit_byte(value >> shift);
+        }
+    };
+
+    auto emit_quad = [&](const uint64_t value) -> void
+    {
+        for(int shift = 0; shift < 64; shift += 8) {
+            emit_byte(value >> shift);
+        }
+    };
+
+    auto emit_string = [&](const std::string& value) -> void
+    {
+        record.insert(record.end(), value.begin(), value.end());
+        emit_byte(0);
+    };
+
+    auto begin_record = [&](const uint32_t id) -> void
+    {
+        record.clear();
+        emit_long(id);
+        emit_long(0);
+        emit_quad(timestamp());
+    };
+
+    auto end_record = [&]() -> void
+    {
+        const uint32_t size = record.size();
+        for(int shift = 0; shift < 32; shift += 8) {
+            record[4 + (shift / 8)] = (size >> shift);
+        }
+        write(_jitdump, record);
+    };
+
+    auto debug_info = [&]() -> void
+    {
+        std::vector<const BasicBlock*> blocks;
+        for(auto& block : function.basic_blocks()) {
+            if((block.origin() == BasicBlock::NO_ORIGIN) || (block.begin() == block.end())) {
+                continue;
+            }
+            if((block.begin() >= range.begin) && (block.end() <= range.end)) {
+                blocks.push_back(&block);
+            }
+        }
+        if(blocks.empty()) {
+            return;
+        }
+        begin_record(JIT_CODE_DEBUG_INFO);
+        emit_quad(reinterpret_cast<uintptr_t>(range.begin));
+        emit_quad(blocks.size());
+        for(auto block : blocks) {
+            emit_quad(reinterpret_cast<uintptr_t>(block->begin()));
+            emit_long(block->origin() + 1);
+            emit_long(0);
+            emit_string(ByteCode::token(bytecode.begin() + block->origin()));
+        }
+        end_record();
+    };
+
+    auto code_load = [&]() -> void
+    {
+        begin_record(JIT_CODE_LOAD);
+        emit_long(::getpid());
+        emit_long(::syscall(SYS_gettid));
+        emit_quad(reinterpret_cast<uintptr_t>(range.begin));
+        emit_quad(reinterpret_cast<uintptr_t>(range.begin));
+        emit_quad(range.end - range.begin);
+        emit_quad(_index++);
+        emit_string(name);
+        record.insert(record.end(), range.begin, range.end);
+        end_record();
+    };
+
+    debug_info();
+    code_load();
+}
+
+void Profiler::write(const int fd, const std::vector<uint8_t>& buffer)
+{
+    const uint8_t* data = buffer.data();
+    size_t         size = buffer.size();
+
+    while(size > 0) {
+        const ssize_t count = ::write(fd, data, size);
+        if(count < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        data += count;
+        size -= count;
+    }
+}
+
+uint64_t Profiler::timestamp()
+{
+    struct timespec now;
+
+    if(::clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return 0;
+    }
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000000UL) + now.tv_nsec;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
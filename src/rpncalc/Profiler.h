@@ -0,0 +1,88 @@
+/*
+ * Profiler.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Profiler_h__
+#define __RPN_Profiler_h__
+
+#include "ByteCode.h"
+#include "Function.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Profiler
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Profiler
+{
+public: // public interface
+    Profiler();
+
+    Profiler(Profiler&&) = delete;
+
+    Profiler& operator=(Profiler&&) = delete;
+
+    Profiler(const Profiler&) = delete;
+
+    Profiler& operator=(const Profiler&) = delete;
+
+    virtual ~Profiler();
+
+    void open_perf_map();
+
+    void open_jitdump();
+
+    bool enabled() const
+    {
+        return (_perf_map >= 0) || (_jitdump >= 0);
+    }
+
+    void load(const std::string& name, const ByteCode& bytecode, const Function& function);
+
+    static std::string label(const ByteCode& bytecode);
+
+public: // public static data
+    static constexpr uint32_t JITDUMP_MAGIC       = 0x4a695444;
+    static constexpr uint32_t JITDUMP_VERSION     = 1;
+    static constexpr uint32_t JIT_CODE_LOAD       = 0;
+    static constexpr uint32_t JIT_CODE_DEBUG_INFO = 2;
+    static constexpr uint32_t JIT_CODE_CLOSE      = 3;
+    static constexpr size_t   LABEL_LENGTH        = 96;
+
+private: // private interface
+    void write_perf_map(const Function::Range& range, const std::string& name);
+
+    void write_jitdump(const Function::Range& range, const std::string& name, const ByteCode& bytecode, const Function& function);
+
+    void write(const int fd, const std::vector<uint8_t>& buffer);
+
+    static uint64_t timestamp();
+
+private: // private data
+    int      _perf_map;
+    int      _jitdump;
+    void*    _marker;
+    size_t   _marker_size;
+    uint64_t _index;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Profiler_h__ */
@@ -146,6 +146,88 @@ void Program::run()
         return false;
     };
 
+    auto opt_jit = [&](const std::string& argument) -> bool
+    {
+        if(argument == "--jit=baseline") {
+            _calculator.set_mode(Translator::MODE_BASELINE);
+            return true;
+        }
+        if(argument == "--jit=tos") {
+            _calculator.set_mode(Translator::MODE_TOS);
+            return true;
+        }
+        if(argument == "--jit=optimizing") {
+            _calculator.set_mode(Translator::MODE_OPTIMIZING);
+            return true;
+        }
+        if(argument == "--tiered") {
+            _calculator.set_tiered(true);
+            return true;
+        }
+        if(argument == "--no-tiered") {
+            _calculator.set_tiered(false);
+            return true;
+        }
+        return false;
+    };
+
+    auto opt_cache = [&](const std::string& argument) -> bool
+    {
+        const char*  prefix = "--cache=";
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            _calculator.set_cache(::strtoull(argument.c_str() + length, nullptr, 10));
+            return true;
+        }
+        return false;
+    };
+
+    auto opt_archive = [&](const std::string& argument) -> bool
+    {
+        const char*  prefix = "--archive=";
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            _calculator.set_archive(argument.substr(length));
+            return true;
+        }
+        return false;
+    };
+
+    auto opt_stack = [&](const std::string& argument) -> bool
+    {
+        const char*  prefix = "--stack=";
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            _calculator.set_stack(::strtoull(argument.c_str() + length, nullptr, 10));
+            return true;
+        }
+        return false;
+    };
+
+    auto opt_profile = [&](const std::string& argument) -> bool
+    {
+        if(argument == "--perf-map") {
+            _calculator.set_perf_map();
+            return true;
+        }
+        if(argument == "--jitdump") {
+            _calculator.set_jitdump();
+            return true;
+        }
+        return false;
+    };
+
+    auto opt_dump = [&](const std::string& argument) -> bool
+    {
+        const char*  prefix = "--dump=";
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            _calculator.set_dump(argument.substr(length));
+            return true;
+        }
+        return false;
+    };
+
     auto arg_execute = [&](const std::string& argument) -> bool
     {
         if(argument == "execute") {
@@ -157,6 +239,12 @@ void Program::run()
 
     auto arg_compile = [&](const std::string& argument) -> bool
     {
+        const char*  prefix = "compile=";
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            _calculator.compile(expression, argument.substr(length));
+            return true;
+        }
         if(argument == "compile") {
             _calculator.compile(expression);
             return true;
@@ -169,10 +257,18 @@ void Program::run()
         const char*  prefix = "run=";
         const size_t length = ::strlen(prefix);
         if(argument.compare(0, length, prefix) == 0) {
-            int count = ::atoi(argument.data() + length);
-            while(count > 0) {
-                _calculator.run();
-                --count;
+            const char* name  = argument.data() + length;
+            const char* count = ::strchr(name, ':');
+            if(::isdigit(*name)) {
+                const char* every = ::strchr(name, ',');
+                _calculator.run(::strtoull(name, nullptr, 10), (every != nullptr ? ::strtoull(every + 1, nullptr, 10) : 0));
+            }
+            else if(count != nullptr) {
+                const char* every = ::strchr(count, ',');
+                _calculator.run(std::string(name, count), ::strtoull(count + 1, nullptr, 10), (every != nullptr ? ::strtoull(every + 1, nullptr, 10) : 0));
+            }
+            else {
+                _calculator.run(std::string(name), 1, 0);
             }
             return true;
         }
@@ -183,6 +279,17 @@ void Program::run()
         return false;
     };
 
+    auto arg_aot = [&](const std::string& argument) -> bool
+    {
+        const char*  prefix = "aot=";
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            _calculator.aot(argument.substr(length));
+            return true;
+        }
+        return false;
+    };
+
     auto arg_clear = [&](const std::string& argument) -> bool
     {
         if(argument == "clear") {
@@ -226,6 +333,18 @@ void Program::run()
         stream << "    --alert, --no-alert          enable/disable alert log level"        << std::endl;
         stream << "    --error, --no-error          enable/disable error log level"        << std::endl;
         stream << ""                                                                       << std::endl;
+        stream << "    --jit=baseline               translate with the baseline JIT"       << std::endl;
+        stream << "    --jit=tos                    translate with the top-of-stack JIT"   << std::endl;
+        stream << "    --jit=optimizing             translate with the optimizing JIT"     << std::endl;
+        stream << "    --tiered, --no-tiered        enable/disable tiered execution"       << std::endl;
+        stream << "    --cache=n                    cache up to <n> compiled expressions"  << std::endl;
+        stream << "    --archive=dir                save/load the machine code in <dir>"   << std::endl;
+        stream << "    --stack=n                    set the stack capacity to <n> operands" << std::endl;
+        stream << "    --perf-map                   write /tmp/perf-<pid>.map for perf"    << std::endl;
+        stream << "    --jitdump                    write jit-<pid>.dump for perf inject"  << std::endl;
+        stream << "    --dump=bytecode              print the bytecode of the expressions" << std::endl;
+        stream << "    --dump=hostcode              print the generated machine code"      << std::endl;
+        stream << ""                                                                       << std::endl;
         stream << "Expr:"                                                                  << std::endl;
         stream << ""                                                                       << std::endl;
         stream << "    a valid RPN expression"                                             << std::endl;
@@ -234,7 +353,11 @@ void Program::run()
         stream << ""                                                                       << std::endl;
         stream << "    execute                     execute an RPN expression"              << std::endl;
         stream << "    compile                     compile an RPN expression"              << std::endl;
-        stream << "    run{=n}                     run the compiled expression <n> times"  << std::endl;
+        stream << "    run{=n{,k}}                 run the compiled expression <n> times"  << std::endl;
+        stream << "                                and print the result every <k> runs"    << std::endl;
+        stream << "    compile=name                compile an RPN expression as <name>"    << std::endl;
+        stream << "    run=name{:n{,k}}            run the function <name> <n> times"      << std::endl;
+        stream << "    aot=name                    write the function <name> to an object" << std::endl;
         stream << "    clear                       clear the stack"                        << std::endl;
         stream << ""                                                                       << std::endl;
     };
@@ -267,6 +390,24 @@ void Program::run()
             else if(opt_error(argument)) {
                 continue;
             }
+            else if(opt_jit(argument)) {
+                continue;
+            }
+            else if(opt_cache(argument)) {
+                continue;
+            }
+            else if(opt_archive(argument)) {
+                continue;
+            }
+            else if(opt_stack(argument)) {
+                continue;
+            }
+            else if(opt_profile(argument)) {
+                continue;
+            }
+            else if(opt_dump(argument)) {
+                continue;
+            }
             else if(arg_execute(argument)) {
                 continue;
             }
@@ -276,6 +417,9 @@ void Program::run()
             else if(arg_run(argument)) {
                 continue;
             }
+            else if(arg_aot(argument)) {
+                continue;
+            }
             else if(arg_clear(argument)) {
                 continue;
             }
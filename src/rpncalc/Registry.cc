@@ -0,0 +1,83 @@
+/*
+ * Registry.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Registry.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Registry
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Registry::Registry()
+    : _entries()
+{
+}
+
+Registry::Entry& Registry::acquire(const std::string& name)
+{
+    auto& entry(_entries[name]);
+
+    if(!entry) {
+        entry = std::make_shared<Entry>();
+    }
+    return *entry;
+}
+
+Registry::Entry& Registry::lookup(const std::string& name)
+{
+    auto iterator = _entries.find(name);
+
+    if(iterator == _entries.end()) {
+        throw std::runtime_error(std::string("unknown function") + ' ' + '<' + name + '>');
+    }
+    return *iterator->second;
+}
+
+void Registry::assign(const std::string& name, const std::shared_ptr<Entry>& entry)
+{
+    _entries[name] = entry;
+}
+
+void Registry::for_each(const std::function<void(Entry&)>& callback)
+{
+    for(auto& entry : _entries) {
+        callback(*entry.second);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+/*
+ * Registry.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Registry_h__
+#define __RPN_Registry_h__
+
+#include <map>
+#include <memory>
+#include <functional>
+#include "ByteCode.h"
+#include "HostCode.h"
+#include "Function.h"
+#include "Tiering.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Registry
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Registry
+{
+public: // public interface
+    struct Entry
+    {
+        ByteCode    bytecode;
+        HostCode    hostcode;
+        Function    function;
+        Tiering     tiering;
+        std::string expression;
+        bool        archived;
+    };
+
+    Registry();
+
+    Registry(Registry&&) = delete;
+
+    Registry& operator=(Registry&&) = delete;
+
+    Registry(const Registry&) = delete;
+
+    Registry& operator=(const Registry&) = delete;
+
+    virtual ~Registry() = default;
+
+    Entry& acquire(const std::string& name);
+
+    Entry& lookup(const std::string& name);
+
+    void assign(const std::string& name, const std::shared_ptr<Entry>& entry);
+
+    void for_each(const std::function<void(Entry&)>& callback);
+
+private: // private data
+    std::map<std::string, std::shared_ptr<Entry>> _entries;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Registry_h__ */
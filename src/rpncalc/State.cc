@@ -40,52 +40,64 @@
 
 namespace {
 
+template <bool checked>
 struct Stack
 {
     static int64_t push(rpn::Operands& operands, const int64_t operand)
     {
-        operands.stack.push(operand);
+        auto& stack(operands.stack);
 
-        return operand;
+        if(checked && (operands.status != rpn::Operands::STATUS_OK)) {
+            return 0;
+        }
+        if(checked && (stack.depth >= stack.capacity)) {
+            return fail(operands, rpn::Operands::STATUS_OVERFLOW);
+        }
+        return stack.base[stack.depth++] = operand;
     }
 
     static int64_t top(rpn::Operands& operands)
     {
-        int64_t operand = 0;
+        auto& stack(operands.stack);
 
-        if(operands.stack.empty()) {
-            throw std::runtime_error("stack underflow");
+        if(checked && (operands.status != rpn::Operands::STATUS_OK)) {
+            return 0;
         }
-        else {
-            operand = operands.stack.top();
+        if(checked && (stack.depth == 0)) {
+            return fail(operands, rpn::Operands::STATUS_UNDERFLOW);
         }
-        return operand;
+        return stack.base[stack.depth - 1];
     }
 
     static int64_t pop(rpn::Operands& operands)
     {
-        int64_t operand = 0;
+        auto& stack(operands.stack);
 
-        if(operands.stack.empty()) {
-            throw std::runtime_error("stack underflow");
+        if(checked && (operands.status != rpn::Operands::STATUS_OK)) {
+            return 0;
         }
-        else {
-            operand = operands.stack.top();
-            operands.stack.pop();
+        if(checked && (stack.depth == 0)) {
+            return fail(operands, rpn::Operands::STATUS_UNDERFLOW);
         }
-        return operand;
+        return stack.base[--stack.depth];
     }
 
     static int64_t clear(rpn::Operands& operands)
     {
-        int64_t operand = 0;
+        auto&         stack(operands.stack);
+        const int64_t operand = (stack.depth != 0 ? stack.base[0] : 0);
+
+        stack.depth = 0;
 
-        while(operands.stack.size() > 0) {
-            operand = operands.stack.top();
-            operands.stack.pop();
-        }
         return operand;
     }
+
+    static int64_t fail(rpn::Operands& operands, const int64_t status)
+    {
+        operands.status = status;
+
+        return 0;
+    }
 };
 
 }
@@ -98,19 +110,37 @@ namespace {
 
 struct Array
 {
+    static bool valid(rpn::Operands& operands, const int64_t index)
+    {
+        if(operands.status != rpn::Operands::STATUS_OK) {
+            return false;
+        }
+        if((index < 0) || (static_cast<uint64_t>(index) >= operands.array.size())) {
+            operands.status = rpn::Operands::STATUS_REGISTER;
+            return false;
+        }
+        return true;
+    }
+
     static int64_t set(rpn::Operands& operands, const int64_t index, const int64_t value)
     {
-        return operands.array.at(index) = value;
+        if(valid(operands, index) == false) {
+            return 0;
+        }
+        return operands.array[index] = value;
     }
 
     static int64_t get(rpn::Operands& operands, const int64_t index)
     {
+        if(valid(operands, index) == false) {
+            return 0;
+        }
         switch(index) {
             case rpn::Registers::R30:
                 {
-                    const auto prev_value    = operands.array.at(index);
-                    const auto next_value    = prev_value * 1103515245 + 12345;
-                    operands.array.at(index) = next_value;
+                    const auto prev_value = operands.array[index];
+                    const auto next_value = prev_value * 1103515245 + 12345;
+                    operands.array[index] = next_value;
                 }
                 break;
             case rpn::Registers::R31:
@@ -118,234 +148,549 @@ struct Array
                     const auto now              = std::chrono::system_clock::now();
                     const auto time_since_epoch = now.time_since_epoch();
                     const auto msec_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(time_since_epoch).count();
-                    operands.array.at(index)    = msec_since_epoch;
+                    operands.array[index]       = msec_since_epoch;
                 }
                 break;
             default:
                 break;
         }
-        return operands.array.at(index);
+        return operands.array[index];
     }
 };
 
 }
 
 // ---------------------------------------------------------------------------
-// rpn::Operands
+// <anonymous>::Operations
 // ---------------------------------------------------------------------------
 
-namespace rpn {
+namespace {
+
+template <bool checked>
+struct Operations
+{
+    static int64_t op_nop(rpn::Operands& operands)
+    {
+        return 0;
+    }
+
+    static int64_t op_i64(rpn::Operands& operands, const int64_t operand)
+    {
+        return Stack<checked>::push(operands, operand);
+    }
+
+    static int64_t op_top(rpn::Operands& operands)
+    {
+        return Stack<checked>::top(operands);
+    }
+
+    static int64_t op_pop(rpn::Operands& operands)
+    {
+        return Stack<checked>::pop(operands);
+    }
+
+    static int64_t op_clr(rpn::Operands& operands)
+    {
+        return Stack<checked>::clear(operands);
+    }
+
+    static int64_t op_dup(rpn::Operands& operands)
+    {
+        const int64_t res = Stack<checked>::pop(operands);
+
+        static_cast<void>(Stack<checked>::push(operands, res));
+        static_cast<void>(Stack<checked>::push(operands, res));
+
+        return res;
+    }
+
+    static int64_t op_xch(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        int64_t       res = 0;
+
+        res = Stack<checked>::push(operands, op2);
+        res = Stack<checked>::push(operands, op1);
+
+        return res;
+    }
+
+    static int64_t op_sto(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Array::set(operands, op2, op1);
+
+        return res;
+    }
+
+    static int64_t op_rcl(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Array::get(operands, op2);
+        const int64_t res = Stack<checked>::push(operands, op1);
+
+        return res;
+    }
+
+    static int64_t op_abs(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 < 0 ? -op1 : op1));
+
+        return res;
+    }
+
+    static int64_t op_neg(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (-op1));
+
+        return res;
+    }
+
+    static int64_t op_add(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 + op2));
+
+        return res;
+    }
+
+    static int64_t op_sub(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 - op2));
+
+        return res;
+    }
+
+    static int64_t op_mul(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 * op2));
+
+        return res;
+    }
+
+    static int64_t op_div(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 / op2));
+
+        return res;
+    }
+
+    static int64_t op_mod(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 % op2));
+
+        return res;
+    }
+
+    static int64_t op_cpl(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (~op1));
+
+        return res;
+    }
+
+    static int64_t op_and(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 & op2));
+
+        return res;
+    }
+
+    static int64_t op_ior(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 | op2));
+
+        return res;
+    }
+
+    static int64_t op_xor(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 ^ op2));
+
+        return res;
+    }
+
+    static int64_t op_shl(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 << op2));
+
+        return res;
+    }
+
+    static int64_t op_shr(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 >> op2));
+
+        return res;
+    }
+
+    static int64_t op_inc(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 + 1));
+
+        return res;
+    }
+
+    static int64_t op_dec(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 - 1));
+
+        return res;
+    }
+
+    static int64_t op_hlt(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(op1));
+
+        return op1;
+    }
+
+    static int64_t op_str(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Array::set(operands, operand, op1);
+
+        return res;
+    }
+
+    static int64_t op_rcr(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Array::get(operands, operand);
+        const int64_t res = Stack<checked>::push(operands, op1);
+
+        return res;
+    }
+
+    static int64_t op_adi(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 + operand));
+
+        return res;
+    }
+
+    static int64_t op_mui(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 * operand));
+
+        return res;
+    }
+
+    static int64_t op_stk(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Stack<checked>::top(operands);
+        const int64_t res = Array::set(operands, operand, op1);
+
+        return res;
+    }
+
+    static int64_t op_rcu(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Array::get(operands, operand);
+        const int64_t op2 = Stack<checked>::pop(operands);
+        int64_t       res = 0;
+
+        res = Stack<checked>::push(operands, op1);
+        res = Stack<checked>::push(operands, op2);
+
+        return res;
+    }
+
+    static int64_t op_dad(rpn::Operands& operands)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 + op1));
+
+        return res;
+    }
+
+    static int64_t op_xsb(rpn::Operands& operands)
+    {
+        const int64_t op2 = Stack<checked>::pop(operands);
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op2 - op1));
+
+        return res;
+    }
+
+    static int64_t op_dvi(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 / operand));
+
+        return res;
+    }
+
+    static int64_t op_mdi(rpn::Operands& operands, const int64_t operand)
+    {
+        const int64_t op1 = Stack<checked>::pop(operands);
+        const int64_t res = Stack<checked>::push(operands, (op1 % operand));
+
+        return res;
+    }
+};
 
 }
 
 // ---------------------------------------------------------------------------
-// rpn::Operators
+// rpn::Operands
 // ---------------------------------------------------------------------------
 
 namespace rpn {
 
-int64_t Operators::op_nop(Operands& operands)
-{
-    return 0;
-}
+constexpr size_t Operands::DEFAULT_CAPACITY;
+constexpr size_t Operands::CACHE_LINE_SIZE;
 
-int64_t Operators::op_i64(Operands& operands, const int64_t operand)
+constexpr int64_t Operands::STATUS_OK;
+constexpr int64_t Operands::STATUS_UNDERFLOW;
+constexpr int64_t Operands::STATUS_OVERFLOW;
+constexpr int64_t Operands::STATUS_REGISTER;
+
+Operands::Operands()
+    : Operands(DEFAULT_CAPACITY)
 {
-    return Stack::push(operands, operand);
 }
 
-int64_t Operators::op_top(Operands& operands)
+Operands::Operands(const size_t capacity)
+    : stack{nullptr, 0, 0}
+    , status(STATUS_OK)
+    , array()
 {
-    return Stack::top(operands);
+    reserve(capacity);
 }
 
-int64_t Operators::op_pop(Operands& operands)
+Operands::~Operands()
 {
-    return Stack::pop(operands);
+    ::free(stack.base);
 }
 
-int64_t Operators::op_clr(Operands& operands)
+void Operands::reserve(const size_t capacity)
 {
-    return Stack::clear(operands);
+    const size_t size = (((capacity * sizeof(int64_t)) + (CACHE_LINE_SIZE - 1)) & ~(CACHE_LINE_SIZE - 1));
+
+    if((capacity == 0) || (capacity < stack.depth)) {
+        throw std::runtime_error("invalid stack capacity");
+    }
+    int64_t* base = static_cast<int64_t*>(::aligned_alloc(CACHE_LINE_SIZE, size));
+    if(base == nullptr) {
+        throw std::runtime_error("unable to allocate the stack");
+    }
+    if(stack.base != nullptr) {
+        std::copy(stack.base, stack.base + stack.depth, base);
+        ::free(stack.base);
+    }
+    stack.base     = base;
+    stack.capacity = capacity;
 }
 
-int64_t Operators::op_dup(Operands& operands)
+void Operands::check()
 {
-    const int64_t res = Stack::pop(operands);
+    const int64_t current = status;
 
-    static_cast<void>(Stack::push(operands, res));
-    static_cast<void>(Stack::push(operands, res));
+    status = STATUS_OK;
+    switch(current) {
+        case STATUS_OK:
+            break;
+        case STATUS_UNDERFLOW:
+            throw std::runtime_error("stack underflow");
+        case STATUS_OVERFLOW:
+            throw std::runtime_error("stack overflow");
+        case STATUS_REGISTER:
+            throw std::runtime_error("invalid register");
+        default:
+            throw std::runtime_error("unexpected status");
+    }
+}
 
-    return res;
 }
 
-int64_t Operators::op_xch(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    int64_t       res = 0;
+// ---------------------------------------------------------------------------
+// rpn::Operators
+// ---------------------------------------------------------------------------
 
-    res = Stack::push(operands, op2);
-    res = Stack::push(operands, op1);
+namespace rpn {
 
-    return res;
+#define RPN_DEFINE_OPERATION(name)                             \
+int64_t Operators::op_##name(Operands& operands)               \
+{                                                              \
+    const int64_t res = Operations<true>::op_##name(operands); \
+                                                               \
+    operands.check();                                          \
+                                                               \
+    return res;                                                \
 }
 
-int64_t Operators::op_sto(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Array::set(operands, op2, op1);
-
-    return res;
+#define RPN_DEFINE_OPERATION_WITH_OPERAND(name)                         \
+int64_t Operators::op_##name(Operands& operands, const int64_t operand) \
+{                                                                       \
+    const int64_t res = Operations<true>::op_##name(operands, operand); \
+                                                                        \
+    operands.check();                                                   \
+                                                                        \
+    return res;                                                         \
 }
 
-int64_t Operators::op_rcl(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Array::get(operands, op2);
-    const int64_t res = Stack::push(operands, op1);
+RPN_OPERATIONS(RPN_DEFINE_OPERATION, RPN_DEFINE_OPERATION_WITH_OPERAND)
+
+#undef RPN_DEFINE_OPERATION
+#undef RPN_DEFINE_OPERATION_WITH_OPERAND
 
-    return res;
 }
 
-int64_t Operators::op_abs(Operands& operands)
-{
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 < 0 ? -op1 : op1));
+// ---------------------------------------------------------------------------
+// rpn::Checked
+// ---------------------------------------------------------------------------
 
-    return res;
-}
+namespace rpn {
 
-int64_t Operators::op_neg(Operands& operands)
-{
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (-op1));
+#define RPN_DEFINE_OPERATION(name)                \
+int64_t Checked::op_##name(Operands& operands)    \
+{                                                 \
+    return Operations<true>::op_##name(operands); \
+}
 
-    return res;
+#define RPN_DEFINE_OPERATION_WITH_OPERAND(name)                       \
+int64_t Checked::op_##name(Operands& operands, const int64_t operand) \
+{                                                                     \
+    return Operations<true>::op_##name(operands, operand);            \
 }
 
-int64_t Operators::op_add(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 + op2));
+RPN_OPERATIONS(RPN_DEFINE_OPERATION, RPN_DEFINE_OPERATION_WITH_OPERAND)
+
+#undef RPN_DEFINE_OPERATION
+#undef RPN_DEFINE_OPERATION_WITH_OPERAND
 
-    return res;
 }
 
-int64_t Operators::op_sub(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 - op2));
+// ---------------------------------------------------------------------------
+// rpn::Unchecked
+// ---------------------------------------------------------------------------
 
-    return res;
-}
+namespace rpn {
 
-int64_t Operators::op_mul(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 * op2));
+#define RPN_DEFINE_OPERATION(name)                 \
+int64_t Unchecked::op_##name(Operands& operands)   \
+{                                                  \
+    return Operations<false>::op_##name(operands); \
+}
 
-    return res;
+#define RPN_DEFINE_OPERATION_WITH_OPERAND(name)                         \
+int64_t Unchecked::op_##name(Operands& operands, const int64_t operand) \
+{                                                                       \
+    return Operations<false>::op_##name(operands, operand);             \
 }
 
-int64_t Operators::op_div(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 / op2));
+RPN_OPERATIONS(RPN_DEFINE_OPERATION, RPN_DEFINE_OPERATION_WITH_OPERAND)
+
+#undef RPN_DEFINE_OPERATION
+#undef RPN_DEFINE_OPERATION_WITH_OPERAND
 
-    return res;
 }
 
-int64_t Operators::op_mod(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 % op2));
+// ---------------------------------------------------------------------------
+// rpn::Intrinsics
+// ---------------------------------------------------------------------------
 
-    return res;
-}
+namespace rpn {
 
-int64_t Operators::op_cpl(Operands& operands)
+int64_t Intrinsics::op_sto(Operands& operands, const int64_t op1, const int64_t op2)
 {
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (~op1));
+    const int64_t res = Array::set(operands, op2, op1);
 
     return res;
 }
 
-int64_t Operators::op_and(Operands& operands)
+int64_t Intrinsics::op_rcl(Operands& operands, const int64_t op1)
 {
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 & op2));
+    const int64_t res = Array::get(operands, op1);
 
     return res;
 }
 
-int64_t Operators::op_ior(Operands& operands)
+int64_t Intrinsics::op_hlt(Operands& operands, const int64_t op1)
 {
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 | op2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(op1));
 
-    return res;
+    return op1;
 }
 
-int64_t Operators::op_xor(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 ^ op2));
-
-    return res;
 }
 
-int64_t Operators::op_shl(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 << op2));
+// ---------------------------------------------------------------------------
+// extern "C" entry points
+// ---------------------------------------------------------------------------
 
-    return res;
+extern "C" {
+
+#define RPN_DEFINE_OPERATION(name)                                   \
+int64_t rpncalc_checked_op_##name(rpn::Operands& operands)           \
+{                                                                    \
+    return rpn::Checked::op_##name(operands);                        \
+}                                                                    \
+                                                                     \
+int64_t rpncalc_unchecked_op_##name(rpn::Operands& operands)         \
+{                                                                    \
+    return rpn::Unchecked::op_##name(operands);                      \
 }
 
-int64_t Operators::op_shr(Operands& operands)
-{
-    const int64_t op2 = Stack::pop(operands);
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 >> op2));
-
-    return res;
+#define RPN_DEFINE_OPERATION_WITH_OPERAND(name)                                       \
+int64_t rpncalc_checked_op_##name(rpn::Operands& operands, const int64_t operand)     \
+{                                                                                     \
+    return rpn::Checked::op_##name(operands, operand);                                \
+}                                                                                     \
+                                                                                      \
+int64_t rpncalc_unchecked_op_##name(rpn::Operands& operands, const int64_t operand)   \
+{                                                                                     \
+    return rpn::Unchecked::op_##name(operands, operand);                              \
 }
 
-int64_t Operators::op_inc(Operands& operands)
-{
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 + 1));
+RPN_OPERATIONS(RPN_DEFINE_OPERATION, RPN_DEFINE_OPERATION_WITH_OPERAND)
 
-    return res;
-}
+#undef RPN_DEFINE_OPERATION
+#undef RPN_DEFINE_OPERATION_WITH_OPERAND
 
-int64_t Operators::op_dec(Operands& operands)
+int64_t rpncalc_intrinsics_op_sto(rpn::Operands& operands, const int64_t op1, const int64_t op2)
 {
-    const int64_t op1 = Stack::pop(operands);
-    const int64_t res = Stack::push(operands, (op1 - 1));
-
-    return res;
+    return rpn::Intrinsics::op_sto(operands, op1, op2);
 }
 
-int64_t Operators::op_hlt(Operands& operands)
+int64_t rpncalc_intrinsics_op_rcl(rpn::Operands& operands, const int64_t op1)
 {
-    const int64_t op1 = Stack::pop(operands);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(op1));
+    return rpn::Intrinsics::op_rcl(operands, op1);
+}
 
-    return op1;
+int64_t rpncalc_intrinsics_op_hlt(rpn::Operands& operands, const int64_t op1)
+{
+    return rpn::Intrinsics::op_hlt(operands, op1);
 }
 
 }
@@ -358,6 +703,49 @@ namespace rpn {
 
 }
 
+// ---------------------------------------------------------------------------
+// rpn::Symbols
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+#define RPN_CHECKED_SYMBOL(name) \
+    { "rpncalc_checked_op_" #name, reinterpret_cast<uintptr_t>(&Checked::op_##name) },
+
+#define RPN_UNCHECKED_SYMBOL(name) \
+    { "rpncalc_unchecked_op_" #name, reinterpret_cast<uintptr_t>(&Unchecked::op_##name) },
+
+const std::vector<Symbols::Symbol>& Symbols::table()
+{
+    static const std::vector<Symbol> symbols = {
+        RPN_OPERATIONS(RPN_CHECKED_SYMBOL, RPN_CHECKED_SYMBOL)
+        { "rpncalc_intrinsics_op_sto", reinterpret_cast<uintptr_t>(&Intrinsics::op_sto) },
+        { "rpncalc_intrinsics_op_rcl", reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl) },
+        { "rpncalc_intrinsics_op_hlt", reinterpret_cast<uintptr_t>(&Intrinsics::op_hlt) },
+        RPN_OPERATIONS(RPN_UNCHECKED_SYMBOL, RPN_UNCHECKED_SYMBOL)
+    };
+
+    return symbols;
+}
+
+#undef RPN_CHECKED_SYMBOL
+#undef RPN_UNCHECKED_SYMBOL
+
+bool Symbols::find(const uintptr_t address, uint32_t& index)
+{
+    const auto& symbols(table());
+
+    for(auto& symbol : symbols) {
+        if(symbol.address == address) {
+            index = static_cast<uint32_t>(&symbol - symbols.data());
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
@@ -17,8 +17,8 @@
 #ifndef __RPN_State_h__
 #define __RPN_State_h__
 
-#include <stack>
 #include <array>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 // rpn::Operands
@@ -28,69 +28,145 @@ namespace rpn {
 
 struct Operands
 {
-    std::stack<int64_t>     stack;
-    std::array<int64_t, 32> array;
-};
+    struct Stack
+    {
+        int64_t* base;
+        size_t   depth;
+        size_t   capacity;
+    };
 
-}
+    Operands();
 
-// ---------------------------------------------------------------------------
-// rpn::Operators
-// ---------------------------------------------------------------------------
+    Operands(const size_t capacity);
 
-namespace rpn {
+    Operands(Operands&&) = delete;
 
-struct Operators
-{
-    static int64_t op_nop(Operands& operands);
+    Operands& operator=(Operands&&) = delete;
 
-    static int64_t op_i64(Operands& operands, const int64_t operand);
+    Operands(const Operands&) = delete;
 
-    static int64_t op_top(Operands& operands);
+    Operands& operator=(const Operands&) = delete;
 
-    static int64_t op_pop(Operands& operands);
+    ~Operands();
 
-    static int64_t op_clr(Operands& operands);
+    void reserve(const size_t capacity);
 
-    static int64_t op_dup(Operands& operands);
+    void check();
 
-    static int64_t op_xch(Operands& operands);
+    Stack                   stack;
+    int64_t                 status;
+    std::array<int64_t, 32> array;
 
-    static int64_t op_sto(Operands& operands);
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+    static constexpr size_t CACHE_LINE_SIZE  = 64;
 
-    static int64_t op_rcl(Operands& operands);
+    static constexpr int64_t STATUS_OK        = 0;
+    static constexpr int64_t STATUS_UNDERFLOW = 1;
+    static constexpr int64_t STATUS_OVERFLOW  = 2;
+    static constexpr int64_t STATUS_REGISTER  = 3;
+};
 
-    static int64_t op_abs(Operands& operands);
+}
 
-    static int64_t op_neg(Operands& operands);
+// ---------------------------------------------------------------------------
+// RPN_OPERATIONS
+// ---------------------------------------------------------------------------
 
-    static int64_t op_add(Operands& operands);
+#define RPN_OPERATIONS(OPERATION, OPERATION_WITH_OPERAND) \
+    OPERATION(nop)                                        \
+    OPERATION_WITH_OPERAND(i64)                           \
+    OPERATION(top)                                        \
+    OPERATION(pop)                                        \
+    OPERATION(clr)                                        \
+    OPERATION(dup)                                        \
+    OPERATION(xch)                                        \
+    OPERATION(sto)                                        \
+    OPERATION(rcl)                                        \
+    OPERATION(abs)                                        \
+    OPERATION(neg)                                        \
+    OPERATION(add)                                        \
+    OPERATION(sub)                                        \
+    OPERATION(mul)                                        \
+    OPERATION(div)                                        \
+    OPERATION(mod)                                        \
+    OPERATION(cpl)                                        \
+    OPERATION(and)                                        \
+    OPERATION(ior)                                        \
+    OPERATION(xor)                                        \
+    OPERATION(shl)                                        \
+    OPERATION(shr)                                        \
+    OPERATION(inc)                                        \
+    OPERATION(dec)                                        \
+    OPERATION(hlt)                                        \
+    OPERATION_WITH_OPERAND(str)                           \
+    OPERATION_WITH_OPERAND(rcr)                           \
+    OPERATION_WITH_OPERAND(adi)                           \
+    OPERATION_WITH_OPERAND(mui)                           \
+    OPERATION_WITH_OPERAND(stk)                           \
+    OPERATION_WITH_OPERAND(rcu)                           \
+    OPERATION(dad)                                        \
+    OPERATION(xsb)                                        \
+    OPERATION_WITH_OPERAND(dvi)                           \
+    OPERATION_WITH_OPERAND(mdi)
+
+#define RPN_DECLARE_OPERATION(name) \
+    static int64_t op_##name(Operands& operands);
+
+#define RPN_DECLARE_OPERATION_WITH_OPERAND(name) \
+    static int64_t op_##name(Operands& operands, const int64_t operand);
 
-    static int64_t op_sub(Operands& operands);
+// ---------------------------------------------------------------------------
+// rpn::Operators
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+struct Operators
+{
+    RPN_OPERATIONS(RPN_DECLARE_OPERATION, RPN_DECLARE_OPERATION_WITH_OPERAND)
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Checked
+// ---------------------------------------------------------------------------
 
-    static int64_t op_mul(Operands& operands);
+namespace rpn {
 
-    static int64_t op_div(Operands& operands);
+struct Checked
+{
+    RPN_OPERATIONS(RPN_DECLARE_OPERATION, RPN_DECLARE_OPERATION_WITH_OPERAND)
+};
 
-    static int64_t op_mod(Operands& operands);
+}
 
-    static int64_t op_cpl(Operands& operands);
+// ---------------------------------------------------------------------------
+// rpn::Unchecked
+// ---------------------------------------------------------------------------
 
-    static int64_t op_and(Operands& operands);
+namespace rpn {
 
-    static int64_t op_ior(Operands& operands);
+struct Unchecked
+{
+    RPN_OPERATIONS(RPN_DECLARE_OPERATION, RPN_DECLARE_OPERATION_WITH_OPERAND)
+};
 
-    static int64_t op_xor(Operands& operands);
+}
 
-    static int64_t op_shl(Operands& operands);
+// ---------------------------------------------------------------------------
+// rpn::Intrinsics
+// ---------------------------------------------------------------------------
 
-    static int64_t op_shr(Operands& operands);
+namespace rpn {
 
-    static int64_t op_inc(Operands& operands);
+struct Intrinsics
+{
+    static int64_t op_sto(Operands& operands, const int64_t op1, const int64_t op2);
 
-    static int64_t op_dec(Operands& operands);
+    static int64_t op_rcl(Operands& operands, const int64_t op1);
 
-    static int64_t op_hlt(Operands& operands);
+    static int64_t op_hlt(Operands& operands, const int64_t op1);
 };
 
 }
@@ -139,6 +215,27 @@ struct Registers
 
 }
 
+// ---------------------------------------------------------------------------
+// rpn::Symbols
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+struct Symbols
+{
+    struct Symbol
+    {
+        const char* name;
+        uintptr_t   address;
+    };
+
+    static const std::vector<Symbol>& table();
+
+    static bool find(const uintptr_t address, uint32_t& index);
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
@@ -0,0 +1,128 @@
+/*
+ * Tiering.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Tiering.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Tiering
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+constexpr int Tiering::TIER_INTERPRETER;
+constexpr int Tiering::TIER_BASELINE;
+constexpr int Tiering::TIER_OPTIMIZING;
+constexpr uint64_t Tiering::BASELINE_THRESHOLD;
+constexpr uint64_t Tiering::OPTIMIZING_THRESHOLD;
+
+Tiering::Tiering()
+    : _enabled(false)
+    , _tier(TIER_INTERPRETER)
+    , _hits(0)
+{
+}
+
+void Tiering::reset()
+{
+    _tier = TIER_INTERPRETER;
+    _hits = 0;
+}
+
+void Tiering::enable(const bool enabled)
+{
+    _enabled = enabled;
+}
+
+bool Tiering::enabled() const
+{
+    return _enabled;
+}
+
+int Tiering::tier() const
+{
+    return _tier;
+}
+
+uint64_t Tiering::hits() const
+{
+    return _hits;
+}
+
+uint64_t Tiering::budget() const
+{
+    auto remaining = [&](const uint64_t threshold) -> uint64_t
+    {
+        if(_hits < threshold) {
+            return threshold - _hits;
+        }
+        return 0;
+    };
+
+    if(_enabled != false) {
+        switch(_tier) {
+            case TIER_INTERPRETER:
+                return remaining(BASELINE_THRESHOLD);
+            case TIER_BASELINE:
+                return remaining(OPTIMIZING_THRESHOLD);
+            default:
+                break;
+        }
+    }
+    else if(_tier == TIER_INTERPRETER) {
+        return 0;
+    }
+    return UINT64_MAX;
+}
+
+void Tiering::account(const uint64_t count)
+{
+    _hits += count;
+}
+
+void Tiering::promote()
+{
+    if(_enabled != false) {
+        if(_tier < TIER_OPTIMIZING) {
+            ++_tier;
+        }
+    }
+    else {
+        _tier = TIER_OPTIMIZING;
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+/*
+ * Tiering.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Tiering_h__
+#define __RPN_Tiering_h__
+
+// ---------------------------------------------------------------------------
+// rpn::Tiering
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Tiering
+{
+public: // public interface
+    Tiering();
+
+    Tiering(Tiering&&) = delete;
+
+    Tiering& operator=(Tiering&&) = delete;
+
+    Tiering(const Tiering&) = delete;
+
+    Tiering& operator=(const Tiering&) = delete;
+
+    virtual ~Tiering() = default;
+
+    void reset();
+
+    void enable(const bool enabled);
+
+    bool enabled() const;
+
+    int tier() const;
+
+    uint64_t hits() const;
+
+    uint64_t budget() const;
+
+    void account(const uint64_t count);
+
+    void promote();
+
+public: // public static data
+    static constexpr int TIER_INTERPRETER = 0;
+    static constexpr int TIER_BASELINE    = 1;
+    static constexpr int TIER_OPTIMIZING  = 2;
+
+    static constexpr uint64_t BASELINE_THRESHOLD   = 10;
+    static constexpr uint64_t OPTIMIZING_THRESHOLD = 1000;
+
+private: // private data
+    bool     _enabled;
+    int      _tier;
+    uint64_t _hits;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Tiering_h__ */
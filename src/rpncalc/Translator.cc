@@ -0,0 +1,1550 @@
+/*
+ * Translator.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Translator.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Allocation
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Allocation
+{
+    static constexpr uint8_t NO_REGISTER = 0xff;
+
+    static constexpr uint8_t STATE = rpn::HostCode::RBX;
+
+    static constexpr int NUM_REGISTERS = 4;
+
+    static constexpr uint8_t REGISTERS[NUM_REGISTERS] = {
+        rpn::HostCode::R12,
+        rpn::HostCode::R13,
+        rpn::HostCode::R14,
+        rpn::HostCode::R15,
+    };
+};
+
+constexpr uint8_t Allocation::NO_REGISTER;
+
+constexpr uint8_t Allocation::STATE;
+
+constexpr int Allocation::NUM_REGISTERS;
+
+constexpr uint8_t Allocation::REGISTERS[];
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Division
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Division
+{
+    int64_t multiplier;
+    int     shift;
+    int     power;
+
+    static Division of(const int64_t divisor)
+    {
+        const uint64_t two63 = (static_cast<uint64_t>(1) << 63);
+        const uint64_t ad    = (divisor < 0 ? (0 - static_cast<uint64_t>(divisor)) : divisor);
+
+        if((ad & (ad - 1)) == 0) {
+            int power = 0;
+            while((static_cast<uint64_t>(1) << power) != ad) {
+                ++power;
+            }
+            return Division { 0, 0, power };
+        }
+        const uint64_t t   = (two63 + (static_cast<uint64_t>(divisor) >> 63));
+        const uint64_t anc = (t - 1 - (t % ad));
+        uint64_t q1 = (two63 / anc);
+        uint64_t r1 = (two63 - (q1 * anc));
+        uint64_t q2 = (two63 / ad);
+        uint64_t r2 = (two63 - (q2 * ad));
+        uint64_t delta = 0;
+        int      p     = 63;
+        do {
+            ++p;
+            q1 = (q1 * 2);
+            r1 = (r1 * 2);
+            if(r1 >= anc) {
+                ++q1;
+                r1 -= anc;
+            }
+            q2 = (q2 * 2);
+            r2 = (r2 * 2);
+            if(r2 >= ad) {
+                ++q2;
+                r2 -= ad;
+            }
+            delta = (ad - r2);
+        } while((q1 < delta) || ((q1 == delta) && (r1 == 0)));
+        const int64_t multiplier = static_cast<int64_t>(q2 + 1);
+        return Division { (divisor < 0 ? -multiplier : multiplier), (p - 64), 0 };
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Translator
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Translator::Translator(ByteCode& bytecode, HostCode& hostcode, Function& function, const int mode)
+    : _bytecode(bytecode)
+    , _hostcode(hostcode)
+    , _function(function)
+    , _mode(mode)
+    , _block()
+    , _origin(BasicBlock::NO_ORIGIN)
+    , _entry(nullptr)
+    , _bounds(Verifier::unverified())
+    , _exits()
+    , _unwind()
+    , _cached(0)
+    , _regions()
+    , _region(0)
+    , _saved(0)
+    , _spills(0)
+    , _cache()
+    , _slots()
+    , _free()
+{
+    switch(_mode) {
+        case MODE_BASELINE:
+        case MODE_TOS:
+        case MODE_OPTIMIZING:
+            break;
+        default:
+            throw std::runtime_error("unexpected translation mode");
+    }
+}
+
+void Translator::origin(const size_t origin)
+{
+    _origin = origin;
+}
+
+void Translator::emit_prolog()
+{
+    if(_mode == MODE_OPTIMIZING) {
+        analyze();
+        begin(_regions.at(0).need);
+    }
+    else {
+        begin();
+    }
+    _entry  = _hostcode.end();
+    _bounds = Verifier(_bytecode).verify();
+    _unwind.clear();
+    _unwind.enter(_entry);
+    if(_bounds.verified) {
+        guard();
+    }
+    _hostcode.push_rbp();
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(16);
+    _unwind.offset(HostCode::RBP, -16);
+    _hostcode.mov_rbp_rsp();
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_register(HostCode::RBP);
+    _hostcode.push_r64(Allocation::STATE);
+    _unwind.advance(_hostcode.end());
+    _unwind.offset(Allocation::STATE, -24);
+    _hostcode.mov_r64_r64(Allocation::STATE, HostCode::RDI);
+    if(_mode == MODE_OPTIMIZING) {
+        int high = 0;
+        for(auto& region : _regions) {
+            high = std::max(high, region.high);
+        }
+        _saved  = std::min(high, Allocation::NUM_REGISTERS);
+        _spills = std::max(0, high - Allocation::NUM_REGISTERS);
+        _free.clear();
+        for(int index = 0; index < _saved; ++index) {
+            _free.push_back(index);
+        }
+        for(int index = 0; index < _spills; ++index) {
+            _free.push_back(Allocation::NUM_REGISTERS + index);
+        }
+        for(int index = 0; index < _saved; ++index) {
+            _hostcode.push_r64(Allocation::REGISTERS[index]);
+            _unwind.advance(_hostcode.end());
+            _unwind.offset(Allocation::REGISTERS[index], (-32 - (index * 8)));
+        }
+        const int frame = ((_spills * 8) + (((1 + _saved + _spills) % 2) != 0 ? 8 : 0));
+        if(frame != 0) {
+            _hostcode.sub_r64_imm32(HostCode::RSP, frame);
+        }
+        fill();
+    }
+    else {
+        _hostcode.sub_r64_imm32(HostCode::RSP, 8);
+    }
+    end();
+}
+
+void Translator::emit_epilog()
+{
+    _origin = BasicBlock::NO_ORIGIN;
+    begin(_slots.size() + _cache.size() + _cached);
+    flush();
+    for(auto& exit : _exits) {
+        _hostcode.patch_rel32(exit, _hostcode.end());
+    }
+    _exits.clear();
+    _hostcode.mov_rsp_rbp();
+    _hostcode.sub_r64_imm32(HostCode::RSP, ((1 + _saved) * 8));
+    if(_mode == MODE_OPTIMIZING) {
+        for(int index = _saved - 1; index >= 0; --index) {
+            _hostcode.pop_r64(Allocation::REGISTERS[index]);
+        }
+    }
+    _hostcode.pop_r64(Allocation::STATE);
+    _hostcode.pop_rbp();
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa(HostCode::RSP, 8);
+    _hostcode.ret();
+    _unwind.leave(_hostcode.end());
+    end();
+}
+
+void Translator::emit_loop()
+{
+    BasicBlock block;
+
+    _hostcode.reserve(BLOCK_RESERVE);
+    block.begin(_hostcode.end());
+    _unwind.enter(_hostcode.end());
+    _hostcode.push_r64(HostCode::RBX);
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(16);
+    _unwind.offset(HostCode::RBX, -16);
+    _hostcode.push_r64(HostCode::R12);
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(24);
+    _unwind.offset(HostCode::R12, -24);
+    _hostcode.sub_r64_imm32(HostCode::RSP, 8);
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(32);
+    _hostcode.mov_r64_r64(HostCode::RBX, HostCode::RDI);
+    _hostcode.mov_r64_r64(HostCode::R12, HostCode::RSI);
+    const uint8_t* loop = _hostcode.end();
+    _hostcode.mov_r64_r64(HostCode::RDI, HostCode::RBX);
+    _hostcode.mov_rax_imm64(reinterpret_cast<uintptr_t>(_entry));
+    _hostcode.relocate(HostCode::RELOC_CODE);
+    _hostcode.call_rax();
+    _hostcode.cmp_m64_imm32(HostCode::RBX, offsetof(Operands, status), Operands::STATUS_OK);
+    _hostcode.jnz_rel32(9);
+    _hostcode.dec_r64(HostCode::R12);
+    _hostcode.jnz_rel32(loop - (_hostcode.end() + 6));
+    _hostcode.add_r64_imm32(HostCode::RSP, 8);
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(24);
+    _hostcode.pop_r64(HostCode::R12);
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(16);
+    _hostcode.pop_r64(HostCode::RBX);
+    _unwind.advance(_hostcode.end());
+    _unwind.def_cfa_offset(8);
+    _hostcode.ret();
+    _unwind.leave(_hostcode.end());
+    block.end(_hostcode.end());
+    _function.add_loop(block);
+    _hostcode.add_frames(_unwind.eh_frame());
+    _unwind.clear();
+}
+
+void Translator::emit_nop()
+{
+    begin();
+    end();
+}
+
+void Translator::emit_i64(const int64_t operand)
+{
+    begin();
+    push(operand);
+    end();
+}
+
+void Translator::emit_top()
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached == 0) {
+                call(operation(&Checked::op_top, &Unchecked::op_top));
+            }
+            break;
+        case MODE_TOS:
+            if((_cache.size() == 0) && (_cached == 0)) {
+                call(operation(&Checked::op_top, &Unchecked::op_top));
+            }
+            break;
+        default:
+            break;
+    }
+    end();
+}
+
+void Translator::emit_pop()
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.pop_r64(HostCode::RAX);
+                --_cached;
+            }
+            else {
+                call(operation(&Checked::op_pop, &Unchecked::op_pop));
+            }
+            break;
+        case MODE_TOS:
+            if(_cache.size() >= 1) {
+                _cache.pop_back();
+            }
+            else if(_cached >= 1) {
+                _hostcode.add_r64_imm32(HostCode::RSP, 8);
+                --_cached;
+            }
+            else {
+                call(operation(&Checked::op_pop, &Unchecked::op_pop));
+            }
+            break;
+        default:
+            release(_slots.back());
+            _slots.pop_back();
+            break;
+    }
+    end();
+}
+
+void Translator::emit_clr()
+{
+    if(_mode == MODE_OPTIMIZING) {
+        begin(_regions.at(_region + 1).need);
+    }
+    else {
+        begin();
+    }
+    switch(_mode) {
+        case MODE_BASELINE:
+        case MODE_TOS:
+            _cache.clear();
+            if(_cached >= 1) {
+                _hostcode.add_r64_imm32(HostCode::RSP, (_cached * 8));
+                _cached = 0;
+            }
+            call(operation(&Checked::op_clr, &Unchecked::op_clr));
+            break;
+        default:
+            for(auto& slot : _slots) {
+                release(slot);
+            }
+            _slots.clear();
+            call(operation(&Checked::op_clr, &Unchecked::op_clr));
+            ++_region;
+            fill();
+            break;
+    }
+    end();
+}
+
+void Translator::emit_dup()
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.mov_r64_m64(HostCode::RAX, HostCode::RSP, 0);
+                push(HostCode::RAX);
+            }
+            else {
+                call(operation(&Checked::op_dup, &Unchecked::op_dup));
+            }
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                push(_cache.back());
+            }
+            else {
+                call(operation(&Checked::op_dup, &Unchecked::op_dup));
+            }
+            break;
+        default:
+            {
+                const uint8_t source = reg(_slots.back());
+                if(source != Allocation::NO_REGISTER) {
+                    push(source);
+                }
+                else {
+                    load(HostCode::RAX, _slots.back());
+                    push(HostCode::RAX);
+                }
+            }
+            break;
+    }
+    end();
+}
+
+void Translator::emit_xch()
+{
+    begin(_cached + _cache.size());
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 2) {
+                _hostcode.pop_r64(HostCode::RAX);
+                _hostcode.pop_r64(HostCode::RCX);
+                _hostcode.push_r64(HostCode::RAX);
+                _hostcode.push_r64(HostCode::RCX);
+            }
+            else {
+                flush();
+                call(operation(&Checked::op_xch, &Unchecked::op_xch));
+            }
+            break;
+        case MODE_TOS:
+            if(cache(2)) {
+                std::swap(_cache[0], _cache[1]);
+            }
+            else {
+                flush();
+                call(operation(&Checked::op_xch, &Unchecked::op_xch));
+            }
+            break;
+        default:
+            std::swap(_slots[_slots.size() - 1], _slots[_slots.size() - 2]);
+            break;
+    }
+    end();
+}
+
+void Translator::emit_sto()
+{
+    begin(_cached + _cache.size());
+    switch(_mode) {
+        case MODE_BASELINE:
+            flush();
+            call(operation(&Checked::op_sto, &Unchecked::op_sto));
+            break;
+        case MODE_TOS:
+            if(cache(2)) {
+                _hostcode.mov_r64_r64(HostCode::RSI, _cache[0]);
+                if(_cache[1] != HostCode::RDX) {
+                    _hostcode.mov_r64_r64(HostCode::RDX, _cache[1]);
+                }
+                _cache.clear();
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            }
+            else {
+                flush();
+                call(operation(&Checked::op_sto, &Unchecked::op_sto));
+            }
+            break;
+        default:
+            {
+                const uint32_t op2 = _slots.back();
+                _slots.pop_back();
+                const uint32_t op1 = _slots.back();
+                _slots.pop_back();
+                load(HostCode::RSI, op1);
+                load(HostCode::RDX, op2);
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+                release(op1);
+                release(op2);
+            }
+            break;
+    }
+    end();
+}
+
+void Translator::emit_rcl()
+{
+    begin(_cached + _cache.size());
+    switch(_mode) {
+        case MODE_BASELINE:
+            flush();
+            call(operation(&Checked::op_rcl, &Unchecked::op_rcl));
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                spill(1);
+                _hostcode.mov_r64_r64(HostCode::RSI, _cache.back());
+                _cache.clear();
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+                _cache.push_back(HostCode::RAX);
+            }
+            else {
+                call(operation(&Checked::op_rcl, &Unchecked::op_rcl));
+            }
+            break;
+        default:
+            load(HostCode::RSI, _slots.back());
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+            store(_slots.back(), HostCode::RAX);
+            break;
+    }
+    end();
+}
+
+void Translator::emit_abs()
+{
+    return emit_unary(ByteCode::OP_ABS, operation(&Checked::op_abs, &Unchecked::op_abs));
+}
+
+void Translator::emit_neg()
+{
+    return emit_unary(ByteCode::OP_NEG, operation(&Checked::op_neg, &Unchecked::op_neg));
+}
+
+void Translator::emit_add()
+{
+    return emit_binary(ByteCode::OP_ADD, operation(&Checked::op_add, &Unchecked::op_add));
+}
+
+void Translator::emit_sub()
+{
+    return emit_binary(ByteCode::OP_SUB, operation(&Checked::op_sub, &Unchecked::op_sub));
+}
+
+void Translator::emit_mul()
+{
+    return emit_binary(ByteCode::OP_MUL, operation(&Checked::op_mul, &Unchecked::op_mul));
+}
+
+void Translator::emit_div()
+{
+    return emit_binary(ByteCode::OP_DIV, operation(&Checked::op_div, &Unchecked::op_div));
+}
+
+void Translator::emit_mod()
+{
+    return emit_binary(ByteCode::OP_MOD, operation(&Checked::op_mod, &Unchecked::op_mod));
+}
+
+void Translator::emit_cpl()
+{
+    return emit_unary(ByteCode::OP_CPL, operation(&Checked::op_cpl, &Unchecked::op_cpl));
+}
+
+void Translator::emit_and()
+{
+    return emit_binary(ByteCode::OP_AND, operation(&Checked::op_and, &Unchecked::op_and));
+}
+
+void Translator::emit_ior()
+{
+    return emit_binary(ByteCode::OP_IOR, operation(&Checked::op_ior, &Unchecked::op_ior));
+}
+
+void Translator::emit_xor()
+{
+    return emit_binary(ByteCode::OP_XOR, operation(&Checked::op_xor, &Unchecked::op_xor));
+}
+
+void Translator::emit_shl()
+{
+    return emit_binary(ByteCode::OP_SHL, operation(&Checked::op_shl, &Unchecked::op_shl));
+}
+
+void Translator::emit_shr()
+{
+    return emit_binary(ByteCode::OP_SHR, operation(&Checked::op_shr, &Unchecked::op_shr));
+}
+
+void Translator::emit_inc()
+{
+    return emit_unary(ByteCode::OP_INC, operation(&Checked::op_inc, &Unchecked::op_inc));
+}
+
+void Translator::emit_dec()
+{
+    return emit_unary(ByteCode::OP_DEC, operation(&Checked::op_dec, &Unchecked::op_dec));
+}
+
+void Translator::emit_hlt()
+{
+    begin(_cached + _cache.size());
+    switch(_mode) {
+        case MODE_BASELINE:
+            flush();
+            call(operation(&Checked::op_hlt, &Unchecked::op_hlt));
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                spill(1);
+                _hostcode.mov_r64_r64(HostCode::RSI, _cache.back());
+                _cache.clear();
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_hlt));
+            }
+            else {
+                call(operation(&Checked::op_hlt, &Unchecked::op_hlt));
+            }
+            break;
+        default:
+            load(HostCode::RSI, _slots.back());
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_hlt));
+            release(_slots.back());
+            _slots.pop_back();
+            break;
+    }
+    end();
+}
+
+void Translator::emit_str(const uint8_t operand)
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.pop_r64(HostCode::RSI);
+                --_cached;
+                _hostcode.mov_r64_imm32(HostCode::RDX, operand);
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            }
+            else {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(operation(&Checked::op_str, &Unchecked::op_str));
+            }
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                spill(1);
+                _hostcode.mov_r64_r64(HostCode::RSI, _cache.back());
+                _hostcode.mov_r64_imm32(HostCode::RDX, operand);
+                _cache.clear();
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            }
+            else {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(operation(&Checked::op_str, &Unchecked::op_str));
+            }
+            break;
+        default:
+            load(HostCode::RSI, _slots.back());
+            _hostcode.mov_r64_imm32(HostCode::RDX, operand);
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            release(_slots.back());
+            _slots.pop_back();
+            break;
+    }
+    end();
+}
+
+void Translator::emit_rcr(const uint8_t operand)
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+            push(HostCode::RAX);
+            break;
+        case MODE_TOS:
+            spill(0);
+            _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+            push(HostCode::RAX);
+            break;
+        default:
+            _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+            push(HostCode::RAX);
+            break;
+    }
+    end();
+}
+
+void Translator::emit_adi(const int64_t operand)
+{
+    return emit_immediate(ByteCode::OP_ADI, operand, operation(&Checked::op_adi, &Unchecked::op_adi));
+}
+
+void Translator::emit_mui(const int64_t operand)
+{
+    return emit_immediate(ByteCode::OP_MUI, operand, operation(&Checked::op_mui, &Unchecked::op_mui));
+}
+
+void Translator::emit_stk(const uint8_t operand)
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.mov_r64_m64(HostCode::RSI, HostCode::RSP, 0);
+                _hostcode.mov_r64_imm32(HostCode::RDX, operand);
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            }
+            else {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(operation(&Checked::op_stk, &Unchecked::op_stk));
+            }
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                _hostcode.mov_r64_r64(HostCode::RSI, _cache.back());
+                spill(0);
+                _hostcode.mov_r64_imm32(HostCode::RDX, operand);
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            }
+            else {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(operation(&Checked::op_stk, &Unchecked::op_stk));
+            }
+            break;
+        default:
+            load(HostCode::RSI, _slots.back());
+            _hostcode.mov_r64_imm32(HostCode::RDX, operand);
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_sto));
+            break;
+    }
+    end();
+}
+
+void Translator::emit_rcu(const uint8_t operand)
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+                _hostcode.pop_r64(HostCode::RCX);
+                _hostcode.push_r64(HostCode::RAX);
+                _hostcode.push_r64(HostCode::RCX);
+                ++_cached;
+            }
+            else {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(operation(&Checked::op_rcu, &Unchecked::op_rcu));
+            }
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                spill(0);
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+                _hostcode.pop_r64(HostCode::RDX);
+                --_cached;
+                _cache.push_back(HostCode::RAX);
+                _cache.push_back(HostCode::RDX);
+            }
+            else {
+                _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+                call(operation(&Checked::op_rcu, &Unchecked::op_rcu));
+            }
+            break;
+        default:
+            _hostcode.mov_r64_imm32(HostCode::RSI, operand);
+            call(reinterpret_cast<uintptr_t>(&Intrinsics::op_rcl));
+            push(HostCode::RAX);
+            std::swap(_slots[_slots.size() - 1], _slots[_slots.size() - 2]);
+            break;
+    }
+    end();
+}
+
+void Translator::emit_dad()
+{
+    return emit_unary(ByteCode::OP_DAD, operation(&Checked::op_dad, &Unchecked::op_dad));
+}
+
+void Translator::emit_xsb()
+{
+    return emit_binary(ByteCode::OP_XSB, operation(&Checked::op_xsb, &Unchecked::op_xsb));
+}
+
+void Translator::emit_dvi(const int64_t operand)
+{
+    return emit_immediate(ByteCode::OP_DVI, operand, operation(&Checked::op_dvi, &Unchecked::op_dvi));
+}
+
+void Translator::emit_mdi(const int64_t operand)
+{
+    return emit_immediate(ByteCode::OP_MDI, operand, operation(&Checked::op_mdi, &Unchecked::op_mdi));
+}
+
+void Translator::analyze()
+{
+    _regions.clear();
+    for(auto& region : Verifier(_bytecode).regions()) {
+        _regions.push_back(Region { static_cast<int>(-region.lowest), static_cast<int>(region.highest - region.lowest) });
+    }
+}
+
+void Translator::begin()
+{
+    begin(0);
+}
+
+void Translator::begin(const size_t values)
+{
+    const uint8_t* current = _hostcode.end();
+
+    _hostcode.reserve(BLOCK_RESERVE + (values * VALUE_RESERVE));
+    if(_hostcode.end() != current) {
+        _unwind.split((current + HostCode::CHAIN_SIZE), _hostcode.end());
+    }
+    _block.reset();
+    _block.begin(_hostcode.end());
+    _block.origin(_origin);
+}
+
+void Translator::end()
+{
+    _block.end(_hostcode.end());
+    _function.add(_block);
+}
+
+void Translator::guard()
+{
+    const int32_t depth    = (offsetof(Operands, stack) + offsetof(Operands::Stack, depth));
+    const int32_t capacity = (offsetof(Operands, stack) + offsetof(Operands::Stack, capacity));
+    const int32_t status   = offsetof(Operands, status);
+
+    auto check = [&](const int64_t error) -> void
+    {
+        _hostcode.jae_rel32(9);
+        _hostcode.mov_m64_imm32(HostCode::RDI, status, error);
+        _hostcode.ret();
+    };
+
+    _hostcode.mov_r64_m64(HostCode::RAX, HostCode::RDI, depth);
+    if(_bounds.need != 0) {
+        _hostcode.cmp_r64_imm32(HostCode::RAX, _bounds.need);
+        check(Operands::STATUS_UNDERFLOW);
+    }
+    _hostcode.mov_r64_m64(HostCode::RCX, HostCode::RDI, capacity);
+    if(_bounds.limit != 0) {
+        _hostcode.cmp_r64_imm32(HostCode::RCX, _bounds.limit);
+        check(Operands::STATUS_OVERFLOW);
+    }
+    if(_bounds.room != 0) {
+        _hostcode.sub_r64_r64(HostCode::RCX, HostCode::RAX);
+        _hostcode.cmp_r64_imm32(HostCode::RCX, _bounds.room);
+        check(Operands::STATUS_OVERFLOW);
+    }
+}
+
+uintptr_t Translator::operation(Operator checked, Operator unchecked) const
+{
+    return reinterpret_cast<uintptr_t>(_bounds.verified ? unchecked : checked);
+}
+
+uintptr_t Translator::operation(OperatorWithOperand checked, OperatorWithOperand unchecked) const
+{
+    return reinterpret_cast<uintptr_t>(_bounds.verified ? unchecked : checked);
+}
+
+void Translator::call(const uintptr_t address)
+{
+    const bool misaligned = ((_cached % 2) != 0);
+
+    if(misaligned) {
+        _hostcode.sub_r64_imm32(HostCode::RSP, 8);
+    }
+    _hostcode.mov_r64_r64(HostCode::RDI, Allocation::STATE);
+    _hostcode.mov_rax_imm64(address);
+    _hostcode.relocate(HostCode::RELOC_FUNCTION);
+    _hostcode.call_rax();
+    if(misaligned) {
+        _hostcode.add_r64_imm32(HostCode::RSP, 8);
+    }
+    _hostcode.cmp_m64_imm32(Allocation::STATE, offsetof(Operands, status), Operands::STATUS_OK);
+    _hostcode.jnz_rel32(0);
+    _exits.push_back(_hostcode.end() - 4);
+}
+
+void Translator::check(const int64_t error)
+{
+    _hostcode.jae_rel32(0);
+    const uint8_t* skip = _hostcode.end() - 4;
+    _hostcode.mov_m64_imm32(Allocation::STATE, offsetof(Operands, status), error);
+    _hostcode.jmp_rel32(0);
+    _exits.push_back(_hostcode.end() - 4);
+    _hostcode.patch_rel32(skip, _hostcode.end());
+}
+
+void Translator::fill()
+{
+    const int32_t base  = (offsetof(Operands, stack) + offsetof(Operands::Stack, base));
+    const int32_t depth = (offsetof(Operands, stack) + offsetof(Operands::Stack, depth));
+    const int     need  = _regions.at(_region).need;
+
+    for(int index = 0; index < need; ++index) {
+        _slots.push_back(allocate());
+    }
+    if(need == 0) {
+        return;
+    }
+    _hostcode.mov_r64_m64(HostCode::RAX, Allocation::STATE, depth);
+    if(!_bounds.verified) {
+        _hostcode.cmp_r64_imm32(HostCode::RAX, need);
+        check(Operands::STATUS_UNDERFLOW);
+    }
+    _hostcode.sub_r64_imm32(HostCode::RAX, need);
+    _hostcode.mov_m64_r64(Allocation::STATE, depth, HostCode::RAX);
+    _hostcode.mov_r64_m64(HostCode::RCX, Allocation::STATE, base);
+    _hostcode.lea_r64_sib(HostCode::RCX, HostCode::RCX, HostCode::RAX, 8);
+    for(int index = 0; index < need; ++index) {
+        const uint8_t target = reg(_slots[index]);
+        if(target != Allocation::NO_REGISTER) {
+            _hostcode.mov_r64_m64(target, HostCode::RCX, (index * 8));
+        }
+        else {
+            _hostcode.mov_r64_m64(HostCode::RAX, HostCode::RCX, (index * 8));
+            store(_slots[index], HostCode::RAX);
+        }
+    }
+}
+
+void Translator::flush()
+{
+    const int32_t base     = (offsetof(Operands, stack) + offsetof(Operands::Stack, base));
+    const int32_t depth    = (offsetof(Operands, stack) + offsetof(Operands::Stack, depth));
+    const int32_t capacity = (offsetof(Operands, stack) + offsetof(Operands::Stack, capacity));
+
+    auto prepare = [&](const int count) -> void
+    {
+        _hostcode.mov_r64_m64(HostCode::RAX, Allocation::STATE, depth);
+        if(!_bounds.verified) {
+            _hostcode.mov_r64_m64(HostCode::RCX, Allocation::STATE, capacity);
+            _hostcode.sub_r64_r64(HostCode::RCX, HostCode::RAX);
+            _hostcode.cmp_r64_imm32(HostCode::RCX, count);
+            check(Operands::STATUS_OVERFLOW);
+        }
+        _hostcode.mov_r64_m64(HostCode::RCX, Allocation::STATE, base);
+        _hostcode.lea_r64_sib(HostCode::RCX, HostCode::RCX, HostCode::RAX, 8);
+        _hostcode.add_r64_imm32(HostCode::RAX, count);
+        _hostcode.mov_m64_r64(Allocation::STATE, depth, HostCode::RAX);
+    };
+
+    switch(_mode) {
+        case MODE_BASELINE:
+        case MODE_TOS:
+            spill(0);
+            if(_cached > 0) {
+                const int cached = _cached;
+                prepare(cached);
+                for(int index = 0; index < cached; ++index) {
+                    _hostcode.mov_r64_m64(HostCode::RAX, HostCode::RSP, ((cached - 1 - index) * 8));
+                    _hostcode.mov_m64_r64(HostCode::RCX, (index * 8), HostCode::RAX);
+                }
+                _hostcode.add_r64_imm32(HostCode::RSP, (cached * 8));
+                _cached = 0;
+            }
+            break;
+        default:
+            if(_slots.size() > 0) {
+                const int count = _slots.size();
+                prepare(count);
+                for(int index = 0; index < count; ++index) {
+                    const uint8_t source = reg(_slots[index]);
+                    if(source != Allocation::NO_REGISTER) {
+                        _hostcode.mov_m64_r64(HostCode::RCX, (index * 8), source);
+                    }
+                    else {
+                        load(HostCode::RAX, _slots[index]);
+                        _hostcode.mov_m64_r64(HostCode::RCX, (index * 8), HostCode::RAX);
+                    }
+                    release(_slots[index]);
+                }
+            }
+            _slots.clear();
+            break;
+    }
+}
+
+bool Translator::cache(const size_t count)
+{
+    while((_cache.size() < count) && (_cached > 0)) {
+        const uint8_t reg = available();
+        _hostcode.pop_r64(reg);
+        _cache.insert(_cache.begin(), reg);
+        --_cached;
+    }
+    if(_cache.size() >= count) {
+        return true;
+    }
+    return false;
+}
+
+uint8_t Translator::available() const
+{
+    if((_cache.size() != 0) && (_cache[0] == HostCode::RAX)) {
+        return HostCode::RDX;
+    }
+    return HostCode::RAX;
+}
+
+void Translator::spill(const size_t keep)
+{
+    while(_cache.size() > keep) {
+        _hostcode.push_r64(_cache.front());
+        _cache.erase(_cache.begin());
+        ++_cached;
+    }
+}
+
+void Translator::unary(const uint8_t opcode, const uint8_t reg)
+{
+    switch(opcode) {
+        case ByteCode::OP_ABS:
+            {
+                _hostcode.mov_r64_r64(HostCode::RCX, reg);
+                _hostcode.neg_r64(reg);
+                _hostcode.cmovs_r64_r64(reg, HostCode::RCX);
+            }
+            break;
+        case ByteCode::OP_NEG:
+            _hostcode.neg_r64(reg);
+            break;
+        case ByteCode::OP_CPL:
+            _hostcode.not_r64(reg);
+            break;
+        case ByteCode::OP_INC:
+            _hostcode.inc_r64(reg);
+            break;
+        case ByteCode::OP_DEC:
+            _hostcode.dec_r64(reg);
+            break;
+        case ByteCode::OP_DAD:
+            _hostcode.add_r64_r64(reg, reg);
+            break;
+        default:
+            throw std::runtime_error("unexpected unary opcode");
+    }
+}
+
+void Translator::binary(const uint8_t opcode, const uint8_t dst, const uint8_t src)
+{
+    switch(opcode) {
+        case ByteCode::OP_ADD:
+            _hostcode.add_r64_r64(dst, src);
+            break;
+        case ByteCode::OP_SUB:
+            _hostcode.sub_r64_r64(dst, src);
+            break;
+        case ByteCode::OP_MUL:
+            _hostcode.imul_r64_r64(dst, src);
+            break;
+        case ByteCode::OP_DIV:
+        case ByteCode::OP_MOD:
+            {
+                const uint8_t res = (opcode == ByteCode::OP_DIV ? HostCode::RAX : HostCode::RDX);
+                if(dst != HostCode::RAX) {
+                    _hostcode.mov_r64_r64(HostCode::RAX, dst);
+                }
+                _hostcode.cqo();
+                _hostcode.idiv_r64(src);
+                if(dst != res) {
+                    _hostcode.mov_r64_r64(dst, res);
+                }
+            }
+            break;
+        case ByteCode::OP_AND:
+            _hostcode.and_r64_r64(dst, src);
+            break;
+        case ByteCode::OP_IOR:
+            _hostcode.or_r64_r64(dst, src);
+            break;
+        case ByteCode::OP_XOR:
+            _hostcode.xor_r64_r64(dst, src);
+            break;
+        case ByteCode::OP_SHL:
+        case ByteCode::OP_SHR:
+            if(src != HostCode::RCX) {
+                _hostcode.mov_r64_r64(HostCode::RCX, src);
+            }
+            if(opcode == ByteCode::OP_SHL) {
+                _hostcode.shl_r64_cl(dst);
+            }
+            else {
+                _hostcode.sar_r64_cl(dst);
+            }
+            break;
+        case ByteCode::OP_XSB:
+            _hostcode.neg_r64(dst);
+            _hostcode.add_r64_r64(dst, src);
+            break;
+        default:
+            throw std::runtime_error("unexpected binary opcode");
+    }
+}
+
+void Translator::immediate(const uint8_t opcode, const uint8_t reg, const int64_t operand)
+{
+    const bool imm32 = ((operand >= INT32_MIN) && (operand <= INT32_MAX));
+
+    switch(opcode) {
+        case ByteCode::OP_ADI:
+            if(imm32) {
+                _hostcode.add_r64_imm32(reg, operand);
+            }
+            else {
+                move(HostCode::RCX, operand);
+                _hostcode.add_r64_r64(reg, HostCode::RCX);
+            }
+            break;
+        case ByteCode::OP_MUI:
+            multiply(reg, operand);
+            break;
+        case ByteCode::OP_DVI:
+        case ByteCode::OP_MDI:
+            divide(opcode, reg, operand);
+            break;
+        default:
+            throw std::runtime_error("unexpected immediate opcode");
+    }
+}
+
+void Translator::multiply(const uint8_t reg, const int64_t operand)
+{
+    const bool negative = (operand < 0);
+    uint64_t   factor   = (negative ? (0 - static_cast<uint64_t>(operand)) : operand);
+    uint8_t    shift    = 0;
+
+    while((factor != 0) && ((factor & 1) == 0)) {
+        factor >>= 1;
+        ++shift;
+    }
+    switch(factor) {
+        case 0:
+            _hostcode.xor_r64_r64(reg, reg);
+            break;
+        case 1:
+        case 3:
+        case 5:
+        case 9:
+            if(factor != 1) {
+                _hostcode.lea_r64_sib(reg, reg, reg, (factor - 1));
+            }
+            if(shift != 0) {
+                _hostcode.shl_r64_imm8(reg, shift);
+            }
+            if(negative) {
+                _hostcode.neg_r64(reg);
+            }
+            break;
+        default:
+            if((operand >= INT32_MIN) && (operand <= INT32_MAX)) {
+                _hostcode.imul_r64_imm32(reg, operand);
+            }
+            else {
+                move(HostCode::RCX, operand);
+                _hostcode.imul_r64_r64(reg, HostCode::RCX);
+            }
+            break;
+    }
+}
+
+void Translator::divide(const uint8_t opcode, const uint8_t reg, const int64_t operand)
+{
+    const Division division(Division::of(operand));
+
+    _hostcode.mov_r64_r64(HostCode::RCX, reg);
+    if(division.power != 0) {
+        _hostcode.sar_r64_imm8(HostCode::RCX, 63);
+        _hostcode.shr_r64_imm8(HostCode::RCX, (64 - division.power));
+        _hostcode.add_r64_r64(HostCode::RCX, reg);
+        if(opcode == ByteCode::OP_DVI) {
+            _hostcode.sar_r64_imm8(HostCode::RCX, division.power);
+            if(operand < 0) {
+                _hostcode.neg_r64(HostCode::RCX);
+            }
+            _hostcode.mov_r64_r64(reg, HostCode::RCX);
+        }
+        else {
+            _hostcode.sar_r64_imm8(HostCode::RCX, division.power);
+            _hostcode.shl_r64_imm8(HostCode::RCX, division.power);
+            _hostcode.sub_r64_r64(reg, HostCode::RCX);
+        }
+        return;
+    }
+    move(HostCode::RAX, division.multiplier);
+    _hostcode.imul_r64(HostCode::RCX);
+    if((operand > 0) && (division.multiplier < 0)) {
+        _hostcode.add_r64_r64(HostCode::RDX, HostCode::RCX);
+    }
+    if((operand < 0) && (division.multiplier > 0)) {
+        _hostcode.sub_r64_r64(HostCode::RDX, HostCode::RCX);
+    }
+    if(division.shift != 0) {
+        _hostcode.sar_r64_imm8(HostCode::RDX, division.shift);
+    }
+    _hostcode.mov_r64_r64(HostCode::RAX, HostCode::RDX);
+    _hostcode.shr_r64_imm8(HostCode::RAX, 63);
+    _hostcode.add_r64_r64(HostCode::RDX, HostCode::RAX);
+    if(opcode == ByteCode::OP_MDI) {
+        if((operand >= INT32_MIN) && (operand <= INT32_MAX)) {
+            _hostcode.imul_r64_imm32(HostCode::RDX, operand);
+        }
+        else {
+            move(HostCode::RAX, operand);
+            _hostcode.imul_r64_r64(HostCode::RDX, HostCode::RAX);
+        }
+        _hostcode.sub_r64_r64(HostCode::RCX, HostCode::RDX);
+        _hostcode.mov_r64_r64(reg, HostCode::RCX);
+    }
+    else if(reg != HostCode::RDX) {
+        _hostcode.mov_r64_r64(reg, HostCode::RDX);
+    }
+}
+
+void Translator::emit_unary(const uint8_t opcode, const uintptr_t address)
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.pop_r64(HostCode::RAX);
+                unary(opcode, HostCode::RAX);
+                _hostcode.push_r64(HostCode::RAX);
+            }
+            else {
+                call(address);
+            }
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                unary(opcode, _cache.back());
+            }
+            else {
+                call(address);
+            }
+            break;
+        default:
+            {
+                const uint32_t op1 = _slots.back();
+                const uint8_t dst = reg(op1);
+                if(dst != Allocation::NO_REGISTER) {
+                    unary(opcode, dst);
+                }
+                else {
+                    load(HostCode::RAX, op1);
+                    unary(opcode, HostCode::RAX);
+                    store(op1, HostCode::RAX);
+                }
+            }
+            break;
+    }
+    end();
+}
+
+void Translator::emit_binary(const uint8_t opcode, const uintptr_t address)
+{
+    auto commutative = [&]() -> bool
+    {
+        switch(opcode) {
+            case ByteCode::OP_ADD:
+            case ByteCode::OP_MUL:
+            case ByteCode::OP_AND:
+            case ByteCode::OP_IOR:
+            case ByteCode::OP_XOR:
+                return true;
+            default:
+                break;
+        }
+        return false;
+    };
+
+    auto divide = [&]() -> bool
+    {
+        switch(opcode) {
+            case ByteCode::OP_DIV:
+            case ByteCode::OP_MOD:
+                return true;
+            default:
+                break;
+        }
+        return false;
+    };
+
+    begin(_cached + _cache.size());
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 2) {
+                _hostcode.pop_r64(HostCode::RCX);
+                _hostcode.pop_r64(HostCode::RAX);
+                binary(opcode, HostCode::RAX, HostCode::RCX);
+                _hostcode.push_r64(HostCode::RAX);
+                --_cached;
+            }
+            else {
+                flush();
+                call(address);
+            }
+            break;
+        case MODE_TOS:
+            if(cache(2)) {
+                const uint8_t op2 = _cache.back();
+                _cache.pop_back();
+                if(divide()) {
+                    _hostcode.mov_r64_r64(HostCode::RCX, op2);
+                    binary(opcode, _cache.back(), HostCode::RCX);
+                }
+                else {
+                    binary(opcode, _cache.back(), op2);
+                }
+            }
+            else {
+                flush();
+                call(address);
+            }
+            break;
+        default:
+            {
+                const uint32_t op2 = _slots.back();
+                _slots.pop_back();
+                const uint32_t op1 = _slots.back();
+                uint8_t dst = reg(op1);
+                uint8_t src = reg(op2);
+                if((dst == Allocation::NO_REGISTER) && (src != Allocation::NO_REGISTER) && commutative()) {
+                    load(HostCode::RCX, op1);
+                    binary(opcode, src, HostCode::RCX);
+                    _slots.back() = op2;
+                    release(op1);
+                }
+                else {
+                    if(src == Allocation::NO_REGISTER) {
+                        load((src = HostCode::RCX), op2);
+                    }
+                    if(dst != Allocation::NO_REGISTER) {
+                        binary(opcode, dst, src);
+                    }
+                    else {
+                        load((dst = HostCode::RAX), op1);
+                        binary(opcode, dst, src);
+                        store(op1, dst);
+                    }
+                    release(op2);
+                }
+            }
+            break;
+    }
+    end();
+}
+
+void Translator::emit_immediate(const uint8_t opcode, const int64_t operand, const uintptr_t address)
+{
+    begin();
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(_cached >= 1) {
+                _hostcode.pop_r64(HostCode::RAX);
+                immediate(opcode, HostCode::RAX, operand);
+                _hostcode.push_r64(HostCode::RAX);
+            }
+            else {
+                move(HostCode::RSI, operand);
+                call(address);
+            }
+            break;
+        case MODE_TOS:
+            if(cache(1)) {
+                if((opcode == ByteCode::OP_DVI) || (opcode == ByteCode::OP_MDI)) {
+                    spill(1);
+                }
+                immediate(opcode, _cache.back(), operand);
+            }
+            else {
+                move(HostCode::RSI, operand);
+                call(address);
+            }
+            break;
+        default:
+            {
+                const uint32_t op1 = _slots.back();
+                const uint8_t dst = reg(op1);
+                if(dst != Allocation::NO_REGISTER) {
+                    immediate(opcode, dst, operand);
+                }
+                else {
+                    load(HostCode::RAX, op1);
+                    immediate(opcode, HostCode::RAX, operand);
+                    store(op1, HostCode::RAX);
+                }
+            }
+            break;
+    }
+    end();
+}
+
+uint32_t Translator::allocate()
+{
+    uint32_t location = 0;
+
+    if(_free.empty()) {
+        throw std::runtime_error("no more register available");
+    }
+    std::pop_heap(_free.begin(), _free.end(), std::greater<uint32_t>());
+    location = _free.back();
+    _free.pop_back();
+
+    return location;
+}
+
+void Translator::release(const uint32_t location)
+{
+    _free.push_back(location);
+    std::push_heap(_free.begin(), _free.end(), std::greater<uint32_t>());
+}
+
+uint8_t Translator::reg(const uint32_t location) const
+{
+    if(location < Allocation::NUM_REGISTERS) {
+        return Allocation::REGISTERS[location];
+    }
+    return Allocation::NO_REGISTER;
+}
+
+int32_t Translator::disp(const uint32_t location) const
+{
+    return -8 * (1 + _saved + 1 + (location - Allocation::NUM_REGISTERS));
+}
+
+void Translator::load(const uint8_t reg, const uint32_t location)
+{
+    const uint8_t source = Translator::reg(location);
+
+    if(source == Allocation::NO_REGISTER) {
+        _hostcode.mov_r64_m64(reg, HostCode::RBP, disp(location));
+    }
+    else if(source != reg) {
+        _hostcode.mov_r64_r64(reg, source);
+    }
+}
+
+void Translator::store(const uint32_t location, const uint8_t reg)
+{
+    const uint8_t target = Translator::reg(location);
+
+    if(target == Allocation::NO_REGISTER) {
+        _hostcode.mov_m64_r64(HostCode::RBP, disp(location), reg);
+    }
+    else if(target != reg) {
+        _hostcode.mov_r64_r64(target, reg);
+    }
+}
+
+void Translator::move(const uint8_t reg, const int64_t operand)
+{
+    if((operand >= INT32_MIN) && (operand <= INT32_MAX)) {
+        _hostcode.mov_r64_imm32(reg, operand);
+    }
+    else {
+        _hostcode.mov_r64_imm64(reg, operand);
+    }
+}
+
+void Translator::push(const uint8_t reg)
+{
+    switch(_mode) {
+        case MODE_BASELINE:
+            _hostcode.push_r64(reg);
+            ++_cached;
+            break;
+        case MODE_TOS:
+            {
+                spill(1);
+                const uint8_t target = available();
+                if(target != reg) {
+                    _hostcode.mov_r64_r64(target, reg);
+                }
+                _cache.push_back(target);
+            }
+            break;
+        default:
+            {
+                const uint32_t location = allocate();
+                store(location, reg);
+                _slots.push_back(location);
+            }
+            break;
+    }
+}
+
+void Translator::push(const int64_t operand)
+{
+    const bool imm32 = ((operand >= INT32_MIN) && (operand <= INT32_MAX));
+
+    switch(_mode) {
+        case MODE_BASELINE:
+            if(imm32) {
+                _hostcode.push_imm32(operand);
+                ++_cached;
+            }
+            else {
+                move(HostCode::RAX, operand);
+                push(HostCode::RAX);
+            }
+            break;
+        case MODE_TOS:
+            {
+                spill(1);
+                const uint8_t target = available();
+                move(target, operand);
+                _cache.push_back(target);
+            }
+            break;
+        default:
+            {
+                const uint32_t location = allocate();
+                const uint8_t target   = reg(location);
+                if(target != Allocation::NO_REGISTER) {
+                    move(target, operand);
+                }
+                else {
+                    move(HostCode::RAX, operand);
+                    store(location, HostCode::RAX);
+                }
+                _slots.push_back(location);
+            }
+            break;
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
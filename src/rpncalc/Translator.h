@@ -0,0 +1,234 @@
+/*
+ * Translator.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Translator_h__
+#define __RPN_Translator_h__
+
+#include "State.h"
+#include "ByteCode.h"
+#include "HostCode.h"
+#include "Function.h"
+#include "Verifier.h"
+#include "Unwind.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Translator
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Translator
+{
+public: // public interface
+    Translator(ByteCode&, HostCode&, Function&, const int mode);
+
+    Translator(Translator&&) = delete;
+
+    Translator& operator=(Translator&&) = delete;
+
+    Translator(const Translator&) = delete;
+
+    Translator& operator=(const Translator&) = delete;
+
+    virtual ~Translator() = default;
+
+    void origin(const size_t origin);
+
+    void emit_prolog();
+
+    void emit_epilog();
+
+    void emit_loop();
+
+    void emit_nop();
+
+    void emit_i64(const int64_t operand);
+
+    void emit_top();
+
+    void emit_pop();
+
+    void emit_clr();
+
+    void emit_dup();
+
+    void emit_xch();
+
+    void emit_sto();
+
+    void emit_rcl();
+
+    void emit_abs();
+
+    void emit_neg();
+
+    void emit_add();
+
+    void emit_sub();
+
+    void emit_mul();
+
+    void emit_div();
+
+    void emit_mod();
+
+    void emit_cpl();
+
+    void emit_and();
+
+    void emit_ior();
+
+    void emit_xor();
+
+    void emit_shl();
+
+    void emit_shr();
+
+    void emit_inc();
+
+    void emit_dec();
+
+    void emit_hlt();
+
+    void emit_str(const uint8_t operand);
+
+    void emit_rcr(const uint8_t operand);
+
+    void emit_adi(const int64_t operand);
+
+    void emit_mui(const int64_t operand);
+
+    void emit_stk(const uint8_t operand);
+
+    void emit_rcu(const uint8_t operand);
+
+    void emit_dad();
+
+    void emit_xsb();
+
+    void emit_dvi(const int64_t operand);
+
+    void emit_mdi(const int64_t operand);
+
+public: // public static data
+    static constexpr int MODE_BASELINE   = 0;
+    static constexpr int MODE_TOS        = 1;
+    static constexpr int MODE_OPTIMIZING = 2;
+
+    static constexpr size_t BLOCK_RESERVE = 16384;
+    static constexpr size_t VALUE_RESERVE = 16;
+
+private: // private interface
+    struct Region
+    {
+        int need;
+        int high;
+    };
+
+    using Operator = int64_t (*)(Operands&);
+
+    using OperatorWithOperand = int64_t (*)(Operands&, const int64_t);
+
+    void analyze();
+
+    void guard();
+
+    uintptr_t operation(Operator checked, Operator unchecked) const;
+
+    uintptr_t operation(OperatorWithOperand checked, OperatorWithOperand unchecked) const;
+
+    void begin();
+
+    void begin(const size_t values);
+
+    void end();
+
+    void call(const uintptr_t address);
+
+    void check(const int64_t error);
+
+    void fill();
+
+    void flush();
+
+    bool cache(const size_t count);
+
+    uint8_t available() const;
+
+    void spill(const size_t keep);
+
+    void unary(const uint8_t opcode, const uint8_t reg);
+
+    void binary(const uint8_t opcode, const uint8_t dst, const uint8_t src);
+
+    void immediate(const uint8_t opcode, const uint8_t reg, const int64_t operand);
+
+    void multiply(const uint8_t reg, const int64_t operand);
+
+    void divide(const uint8_t opcode, const uint8_t reg, const int64_t operand);
+
+    void emit_unary(const uint8_t opcode, const uintptr_t address);
+
+    void emit_binary(const uint8_t opcode, const uintptr_t address);
+
+    void emit_immediate(const uint8_t opcode, const int64_t operand, const uintptr_t address);
+
+    uint32_t allocate();
+
+    void release(const uint32_t location);
+
+    uint8_t reg(const uint32_t location) const;
+
+    int32_t disp(const uint32_t location) const;
+
+    void load(const uint8_t reg, const uint32_t location);
+
+    void store(const uint32_t location, const uint8_t reg);
+
+    void move(const uint8_t reg, const int64_t operand);
+
+    void push(const uint8_t reg);
+
+    void push(const int64_t operand);
+
+private: // private data
+    ByteCode&                   _bytecode;
+    HostCode&                   _hostcode;
+    Function&                   _function;
+    const int                   _mode;
+    BasicBlock                  _block;
+    size_t                      _origin;
+    const uint8_t*              _entry;
+    Verifier::Bounds            _bounds;
+    std::vector<const uint8_t*> _exits;
+    Unwind                      _unwind;
+    int                         _cached;
+    std::vector<Region>         _regions;
+    size_t                      _region;
+    int                         _saved;
+    int                         _spills;
+    std::vector<uint8_t>        _cache;
+    std::vector<uint32_t>       _slots;
+    std::vector<uint32_t>       _free;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Translator_h__ */
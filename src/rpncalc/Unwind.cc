@@ -0,0 +1,299 @@
+/*
+ * Unwind.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "HostCode.h"
+#include "Unwind.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Unwind
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+constexpr uint8_t Unwind::DW_CFA_ADVANCE_LOC;
+constexpr uint8_t Unwind::DW_CFA_OFFSET;
+constexpr uint8_t Unwind::DW_CFA_NOP;
+constexpr uint8_t Unwind::DW_CFA_ADVANCE_LOC1;
+constexpr uint8_t Unwind::DW_CFA_ADVANCE_LOC2;
+constexpr uint8_t Unwind::DW_CFA_ADVANCE_LOC4;
+constexpr uint8_t Unwind::DW_CFA_DEF_CFA;
+constexpr uint8_t Unwind::DW_CFA_DEF_CFA_REGISTER;
+constexpr uint8_t Unwind::DW_CFA_DEF_CFA_OFFSET;
+constexpr uint8_t Unwind::DW_REG_RA;
+constexpr int     Unwind::DATA_ALIGNMENT;
+
+Unwind::Unwind()
+    : _frames()
+    , _open(false)
+    , _location(nullptr)
+    , _cfa_register(HostCode::RSP)
+    , _cfa_offset(8)
+    , _saved()
+{
+    clear();
+}
+
+void Unwind::clear()
+{
+    _frames.clear();
+    _open         = false;
+    _location     = nullptr;
+    _cfa_register = HostCode::RSP;
+    _cfa_offset   = 8;
+    _saved.fill(0);
+}
+
+void Unwind::enter(const uint8_t* address)
+{
+    if(_open) {
+        throw std::runtime_error("unwind frame already open");
+    }
+    _frames.push_back(Frame { address, nullptr, {} });
+    _open         = true;
+    _location     = address;
+    _cfa_register = HostCode::RSP;
+    _cfa_offset   = 8;
+    _saved.fill(0);
+}
+
+void Unwind::leave(const uint8_t* address)
+{
+    current().end = address;
+    _open = false;
+}
+
+void Unwind::split(const uint8_t* end, const uint8_t* begin)
+{
+    if(_open == false) {
+        return;
+    }
+    const uint8_t                 cfa_register = _cfa_register;
+    const int32_t                 cfa_offset   = _cfa_offset;
+    const std::array<int32_t, 16> saved        = _saved;
+
+    leave(end);
+    enter(begin);
+    def_cfa(cfa_register, cfa_offset);
+    for(size_t reg = 0; reg < saved.size(); ++reg) {
+        if(saved[reg] != 0) {
+            offset(reg, saved[reg]);
+        }
+    }
+}
+
+void Unwind::advance(const uint8_t* address)
+{
+    const uint64_t delta = (address - _location);
+
+    if(address < _location) {
+        throw std::runtime_error("unwind location moved backwards");
+    }
+    if(delta == 0) {
+        return;
+    }
+    if(delta < 0x40) {
+        emit(DW_CFA_ADVANCE_LOC | delta);
+    }
+    else if(delta <= 0xff) {
+        emit(DW_CFA_ADVANCE_LOC1);
+        emit(delta);
+    }
+    else if(delta <= 0xffff) {
+        emit(DW_CFA_ADVANCE_LOC2);
+        emit(delta >> 0);
+        emit(delta >> 8);
+    }
+    else {
+        emit(DW_CFA_ADVANCE_LOC4);
+        emit(delta >>  0);
+        emit(delta >>  8);
+        emit(delta >> 16);
+        emit(delta >> 24);
+    }
+    _location = address;
+}
+
+void Unwind::def_cfa(const uint8_t reg, const int32_t offset)
+{
+    emit(DW_CFA_DEF_CFA);
+    emit_uleb(dwarf(reg));
+    emit_uleb(offset);
+    _cfa_register = reg;
+    _cfa_offset   = offset;
+}
+
+void Unwind::def_cfa_offset(const int32_t offset)
+{
+    emit(DW_CFA_DEF_CFA_OFFSET);
+    emit_uleb(offset);
+    _cfa_offset = offset;
+}
+
+void Unwind::def_cfa_register(const uint8_t reg)
+{
+    emit(DW_CFA_DEF_CFA_REGISTER);
+    emit_uleb(dwarf(reg));
+    _cfa_register = reg;
+}
+
+void Unwind::offset(const uint8_t reg, const int32_t offset)
+{
+    emit(DW_CFA_OFFSET | dwarf(reg));
+    emit_uleb(offset / DATA_ALIGNMENT);
+    _saved.at(reg) = offset;
+}
+
+std::vector<uint8_t> Unwind::eh_frame() const
+{
+    std::vector<uint8_t> buffer;
+
+    auto emit_byte = [&](const uint8_t value) -> void
+    {
+        buffer.push_back(value);
+    };
+
+    auto emit_long = [&](const uint32_t value) -> void
+    {
+        for(int shift = 0; shift < 32; shift += 8) {
+            emit_byte(value >> shift);
+        }
+    };
+
+    auto emit_quad = [&](const uint64_t value) -> void
+    {
+        for(int shift = 0; shift < 64; shift += 8) {
+            emit_byte(value >> shift);
+        }
+    };
+
+    auto emit_length = [&](const size_t start) -> void
+    {
+        while(((buffer.size() - start) % 8) != 0) {
+            emit_byte(DW_CFA_NOP);
+        }
+        const uint32_t length = (buffer.size() - start - 4);
+        for(int shift = 0; shift < 32; shift += 8) {
+            buffer[start + (shift / 8)] = (length >> shift);
+        }
+    };
+
+    const size_t cie = buffer.size();
+    emit_long(0);
+    emit_long(0);
+    emit_byte(1);
+    emit_byte('z');
+    emit_byte('R');
+    emit_byte('\0');
+    emit_byte(1);
+    emit_byte(DATA_ALIGNMENT & 0x7f);
+    emit_byte(DW_REG_RA);
+    emit_byte(1);
+    emit_byte(0x00);
+    emit_byte(DW_CFA_DEF_CFA);
+    emit_byte(dwarf(HostCode::RSP));
+    emit_byte(8);
+    emit_byte(DW_CFA_OFFSET | DW_REG_RA);
+    emit_byte(1);
+    emit_length(cie);
+    for(auto& frame : _frames) {
+        if((frame.begin == nullptr) || (frame.end == nullptr) || (frame.begin >= frame.end)) {
+            continue;
+        }
+        const size_t fde = buffer.size();
+        emit_long(0);
+        emit_long(buffer.size() - cie);
+        emit_quad(reinterpret_cast<uintptr_t>(frame.begin));
+        emit_quad(frame.end - frame.begin);
+        emit_byte(0);
+        buffer.insert(buffer.end(), frame.instructions.begin(), frame.instructions.end());
+        emit_length(fde);
+    }
+    emit_long(0);
+
+    return buffer;
+}
+
+Unwind::Frame& Unwind::current()
+{
+    if((_open == false) || _frames.empty()) {
+        throw std::runtime_error("no unwind frame is open");
+    }
+    return _frames.back();
+}
+
+void Unwind::emit(const uint8_t value)
+{
+    current().instructions.push_back(value);
+}
+
+void Unwind::emit_uleb(uint64_t value)
+{
+    do {
+        uint8_t byte = (value & 0x7f);
+        value >>= 7;
+        if(value != 0) {
+            byte |= 0x80;
+        }
+        emit(byte);
+    } while(value != 0);
+}
+
+uint8_t Unwind::dwarf(const uint8_t reg)
+{
+    static const uint8_t registers[16] = {
+        0,  /* RAX */
+        2,  /* RCX */
+        1,  /* RDX */
+        3,  /* RBX */
+        7,  /* RSP */
+        6,  /* RBP */
+        4,  /* RSI */
+        5,  /* RDI */
+        8,  /* R8  */
+        9,  /* R9  */
+        10, /* R10 */
+        11, /* R11 */
+        12, /* R12 */
+        13, /* R13 */
+        14, /* R14 */
+        15, /* R15 */
+    };
+
+    return registers[reg & 0x0f];
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
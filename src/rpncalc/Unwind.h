@@ -0,0 +1,108 @@
+/*
+ * Unwind.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Unwind_h__
+#define __RPN_Unwind_h__
+
+#include <array>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// rpn::Unwind
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Unwind
+{
+public: // public interface
+    Unwind();
+
+    Unwind(Unwind&&) = delete;
+
+    Unwind& operator=(Unwind&&) = delete;
+
+    Unwind(const Unwind&) = delete;
+
+    Unwind& operator=(const Unwind&) = delete;
+
+    virtual ~Unwind() = default;
+
+    void clear();
+
+    void enter(const uint8_t* address);
+
+    void leave(const uint8_t* address);
+
+    void split(const uint8_t* end, const uint8_t* begin);
+
+    void advance(const uint8_t* address);
+
+    void def_cfa(const uint8_t reg, const int32_t offset);
+
+    void def_cfa_offset(const int32_t offset);
+
+    void def_cfa_register(const uint8_t reg);
+
+    void offset(const uint8_t reg, const int32_t offset);
+
+    std::vector<uint8_t> eh_frame() const;
+
+public: // public static data
+    static constexpr uint8_t DW_CFA_ADVANCE_LOC      = 0x40;
+    static constexpr uint8_t DW_CFA_OFFSET           = 0x80;
+    static constexpr uint8_t DW_CFA_NOP              = 0x00;
+    static constexpr uint8_t DW_CFA_ADVANCE_LOC1     = 0x02;
+    static constexpr uint8_t DW_CFA_ADVANCE_LOC2     = 0x03;
+    static constexpr uint8_t DW_CFA_ADVANCE_LOC4     = 0x04;
+    static constexpr uint8_t DW_CFA_DEF_CFA          = 0x0c;
+    static constexpr uint8_t DW_CFA_DEF_CFA_REGISTER = 0x0d;
+    static constexpr uint8_t DW_CFA_DEF_CFA_OFFSET   = 0x0e;
+    static constexpr uint8_t DW_REG_RA               = 16;
+    static constexpr int     DATA_ALIGNMENT          = -8;
+
+private: // private interface
+    struct Frame
+    {
+        const uint8_t*       begin;
+        const uint8_t*       end;
+        std::vector<uint8_t> instructions;
+    };
+
+    Frame& current();
+
+    void emit(const uint8_t value);
+
+    void emit_uleb(uint64_t value);
+
+    static uint8_t dwarf(const uint8_t reg);
+
+private: // private data
+    std::vector<Frame>      _frames;
+    bool                    _open;
+    const uint8_t*          _location;
+    uint8_t                 _cfa_register;
+    int32_t                 _cfa_offset;
+    std::array<int32_t, 16> _saved;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Unwind_h__ */
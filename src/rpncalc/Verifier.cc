@@ -0,0 +1,164 @@
+/*
+ * Verifier.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Verifier.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Verifier::Effect
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Verifier::Effect Verifier::Effect::of(const uint8_t opcode)
+{
+    switch(opcode) {
+        case ByteCode::OP_NOP: return Effect { 0, 0 };
+        case ByteCode::OP_I64: return Effect { 0, 1 };
+        case ByteCode::OP_TOP: return Effect { 1, 1 };
+        case ByteCode::OP_POP: return Effect { 1, 0 };
+        case ByteCode::OP_CLR: return Effect { 0, 0 };
+        case ByteCode::OP_DUP: return Effect { 1, 2 };
+        case ByteCode::OP_XCH: return Effect { 2, 2 };
+        case ByteCode::OP_STO: return Effect { 2, 0 };
+        case ByteCode::OP_RCL: return Effect { 1, 1 };
+        case ByteCode::OP_ABS: return Effect { 1, 1 };
+        case ByteCode::OP_NEG: return Effect { 1, 1 };
+        case ByteCode::OP_ADD: return Effect { 2, 1 };
+        case ByteCode::OP_SUB: return Effect { 2, 1 };
+        case ByteCode::OP_MUL: return Effect { 2, 1 };
+        case ByteCode::OP_DIV: return Effect { 2, 1 };
+        case ByteCode::OP_MOD: return Effect { 2, 1 };
+        case ByteCode::OP_CPL: return Effect { 1, 1 };
+        case ByteCode::OP_AND: return Effect { 2, 1 };
+        case ByteCode::OP_IOR: return Effect { 2, 1 };
+        case ByteCode::OP_XOR: return Effect { 2, 1 };
+        case ByteCode::OP_SHL: return Effect { 2, 1 };
+        case ByteCode::OP_SHR: return Effect { 2, 1 };
+        case ByteCode::OP_INC: return Effect { 1, 1 };
+        case ByteCode::OP_DEC: return Effect { 1, 1 };
+        case ByteCode::OP_HLT: return Effect { 1, 0 };
+        case ByteCode::OP_STR: return Effect { 1, 0 };
+        case ByteCode::OP_RCR: return Effect { 0, 1 };
+        case ByteCode::OP_ADI: return Effect { 1, 1 };
+        case ByteCode::OP_MUI: return Effect { 1, 1 };
+        case ByteCode::OP_STK: return Effect { 1, 1 };
+        case ByteCode::OP_RCU: return Effect { 1, 2 };
+        case ByteCode::OP_DAD: return Effect { 1, 1 };
+        case ByteCode::OP_XSB: return Effect { 2, 1 };
+        case ByteCode::OP_DVI: return Effect { 1, 1 };
+        case ByteCode::OP_MDI: return Effect { 1, 1 };
+        default:
+            break;
+    }
+    throw std::runtime_error("unexpected opcode");
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// rpn::Verifier
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+Verifier::Verifier(const ByteCode& bytecode)
+    : _bytecode(bytecode)
+{
+}
+
+Verifier::Bounds Verifier::verify() const
+{
+    const std::vector<Region> all(regions());
+    Bounds                    bounds = Bounds { true, 0, 0, 0 };
+
+    for(auto region = all.begin(); region != all.end(); ++region) {
+        if(region == all.begin()) {
+            bounds.need = -region->lowest;
+            bounds.room = region->highest;
+        }
+        else {
+            if(region->lowest < 0) {
+                return unverified();
+            }
+            bounds.limit = std::max(bounds.limit, region->highest);
+        }
+    }
+    return bounds;
+}
+
+std::vector<Verifier::Region> Verifier::regions() const
+{
+    std::vector<Region> regions;
+    int64_t             depth   = 0;
+    int64_t             lowest  = 0;
+    int64_t             highest = 0;
+
+    auto close = [&]() -> void
+    {
+        regions.push_back(Region { lowest, highest });
+        depth   = 0;
+        lowest  = 0;
+        highest = 0;
+    };
+
+    auto account = [&](const uint8_t opcode) -> void
+    {
+        const Effect effect(Effect::of(opcode));
+        depth  -= effect.pops;
+        lowest  = std::min(lowest, depth);
+        depth  += effect.pushes;
+        highest = std::max(highest, depth);
+    };
+
+    for(const uint8_t* opcode = _bytecode.begin(); opcode < _bytecode.end(); opcode += ByteCode::length(*opcode)) {
+        if(*opcode == ByteCode::OP_CLR) {
+            close();
+        }
+        else {
+            account(*opcode);
+        }
+    }
+    close();
+    return regions;
+}
+
+Verifier::Bounds Verifier::unverified()
+{
+    return Bounds { false, 0, 0, 0 };
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+/*
+ * Verifier.h - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RPN_Verifier_h__
+#define __RPN_Verifier_h__
+
+#include "ByteCode.h"
+
+// ---------------------------------------------------------------------------
+// rpn::Verifier
+// ---------------------------------------------------------------------------
+
+namespace rpn {
+
+class Verifier
+{
+public: // public interface
+    struct Effect
+    {
+        int pops;
+        int pushes;
+
+        static Effect of(const uint8_t opcode);
+    };
+
+    struct Region
+    {
+        int64_t lowest;
+        int64_t highest;
+    };
+
+    struct Bounds
+    {
+        bool    verified;
+        int64_t need;
+        int64_t room;
+        int64_t limit;
+    };
+
+    Verifier(const ByteCode&);
+
+    Verifier(Verifier&&) = delete;
+
+    Verifier& operator=(Verifier&&) = delete;
+
+    Verifier(const Verifier&) = delete;
+
+    Verifier& operator=(const Verifier&) = delete;
+
+    virtual ~Verifier() = default;
+
+    Bounds verify() const;
+
+    std::vector<Region> regions() const;
+
+    static Bounds unverified();
+
+private: // private data
+    const ByteCode& _bytecode;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __RPN_Verifier_h__ */
@@ -0,0 +1,252 @@
+/*
+ * bench.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Console.h"
+#include "Calculator.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Bench
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Bench
+{
+    const char* name;
+    const char* setup;
+    const char* expression;
+};
+
+struct Mode
+{
+    const char* name;
+    int         mode;
+};
+
+struct Stats
+{
+    double min;
+    double median;
+    double p99;
+};
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t opcodes(const std::string& expression)
+{
+    rpn::ByteCode bytecode;
+    rpn::HostCode hostcode;
+    rpn::Function function;
+    rpn::Compiler compiler(bytecode, hostcode, function);
+    uint64_t      count = 0;
+
+    compiler.compile(expression);
+    for(const uint8_t* opcode = bytecode.begin(); opcode < bytecode.end(); opcode += rpn::ByteCode::length(*opcode)) {
+        if(*opcode != rpn::ByteCode::OP_NOP) {
+            ++count;
+        }
+    }
+    return std::max(count, uint64_t(1));
+}
+
+Stats statistics(std::vector<double>& samples)
+{
+    const size_t count = samples.size();
+    const size_t p99   = ((count * 99) + 99) / 100;
+
+    std::sort(samples.begin(), samples.end());
+
+    return Stats { samples.front()
+                 , samples[count / 2]
+                 , samples[std::min(p99, count) - 1] };
+}
+
+std::string json(const double value)
+{
+    char buffer[64];
+
+    static_cast<void>(::snprintf(buffer, sizeof(buffer), "%.3f", value));
+
+    return buffer;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    const std::vector<Bench> benches = {
+        { "arith", "997"         , "3 add 7 mul 5 sub 2 div 11 mod"                 },
+        { "fib"  , "0 1"         , "fib"                                            },
+        { "rnd"  , "now 30 sto 0", "pop rnd abs 127 mod"                            },
+        { "regs" , "1"           , "dup 5 sto 5 rcl 3 mod add 6 sto 6 rcl 1000 mod" },
+    };
+    const std::vector<Mode> modes = {
+        { "baseline"  , rpn::Translator::MODE_BASELINE   },
+        { "tos"       , rpn::Translator::MODE_TOS        },
+        { "optimizing", rpn::Translator::MODE_OPTIMIZING },
+    };
+    uint64_t samples = 201;
+    uint64_t count   = 10000;
+    bool     first   = true;
+
+    auto opt_value = [&](const std::string& argument, const char* prefix, uint64_t& value) -> bool
+    {
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            value = std::max(::strtoull(argument.c_str() + length, nullptr, 10), 1ULL);
+            return true;
+        }
+        return false;
+    };
+
+    for(int argi = 1; argi < argc; ++argi) {
+        const std::string argument(argv[argi]);
+        if(opt_value(argument, "--samples=", samples)) {
+            continue;
+        }
+        if(opt_value(argument, "--count=", count)) {
+            continue;
+        }
+        std::cerr << "invalid argument" << ' ' << '<' << argument << '>' << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    rpn::Console    console(std::cin, std::cout, std::cerr);
+    rpn::Calculator calculator(console);
+
+    auto measure = [&](auto&& prepare, auto&& operation) -> double
+    {
+        prepare();
+        const auto t0 = Clock::now();
+        operation();
+        const auto t1 = Clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count();
+    };
+
+    auto report = [&](const Mode& mode, const Bench& bench, const char* path, const uint64_t ops, const uint64_t runs, std::vector<double>& timings) -> void
+    {
+        const Stats stats(statistics(timings));
+        std::cout << (first ? "" : ",") << std::endl;
+        std::cout << "    {"
+                  << " \"mode\": \""       << mode.name       << "\","
+                  << " \"name\": \""       << bench.name      << "\","
+                  << " \"expression\": \"" << bench.expression << "\","
+                  << " \"path\": \""       << path            << "\","
+                  << " \"ops\": "          << ops             << ","
+                  << " \"runs\": "         << runs            << ","
+                  << " \"samples\": "      << timings.size()  << ","
+                  << " \"min_ns_per_op\": "    << json(stats.min)    << ","
+                  << " \"median_ns_per_op\": " << json(stats.median) << ","
+                  << " \"p99_ns_per_op\": "    << json(stats.p99)    << ","
+                  << " \"ops_per_sec\": "      << json(1.0e9 / stats.median)
+                  << " }";
+        first = false;
+    };
+
+    auto run = [&](const Mode& mode, const Bench& bench) -> void
+    {
+        const uint64_t      ops = opcodes(bench.expression);
+        std::vector<double> timings;
+
+        auto reset = [&]() -> void
+        {
+            calculator.clear();
+            calculator.execute(bench.setup);
+        };
+
+        auto define = [&]() -> void
+        {
+            reset();
+            calculator.compile(bench.expression, "bench");
+        };
+
+        timings.clear();
+        for(uint64_t sample = 0; sample < samples; ++sample) {
+            timings.push_back(measure(reset, [&]() { calculator.execute(bench.expression); }) / ops);
+        }
+        report(mode, bench, "execute", ops, 1, timings);
+
+        timings.clear();
+        for(uint64_t sample = 0; sample < samples; ++sample) {
+            timings.push_back(measure(reset, [&]() { calculator.compile(bench.expression, "bench"); }) / ops);
+        }
+        report(mode, bench, "compile", ops, 1, timings);
+
+        timings.clear();
+        for(uint64_t sample = 0; sample < samples; ++sample) {
+            timings.push_back(measure(define, [&]() { calculator.run("bench", 1, 0); }) / ops);
+        }
+        report(mode, bench, "first_run", ops, 1, timings);
+
+        timings.clear();
+        define();
+        calculator.run("bench", 1, 0);
+        for(uint64_t sample = 0; sample < samples; ++sample) {
+            timings.push_back(measure(reset, [&]() { calculator.run("bench", count, 0); }) / (ops * count));
+        }
+        report(mode, bench, "steady_run", ops, count, timings);
+    };
+
+    try {
+        calculator.set_debug(false);
+        calculator.set_trace(false);
+        calculator.set_print(false);
+        calculator.set_alert(false);
+        calculator.set_error(false);
+        std::cout << "{" << std::endl;
+        std::cout << "  \"samples\": " << samples << "," << std::endl;
+        std::cout << "  \"count\": "   << count   << "," << std::endl;
+        std::cout << "  \"benchmarks\": [";
+        for(auto& mode : modes) {
+            calculator.set_mode(mode.mode);
+            for(auto& bench : benches) {
+                run(mode, bench);
+            }
+        }
+        std::cout << std::endl << "  ]" << std::endl;
+        std::cout << "}" << std::endl;
+    }
+    catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
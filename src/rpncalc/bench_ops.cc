@@ -0,0 +1,279 @@
+/*
+ * bench_ops.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <x86intrin.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "Console.h"
+#include "Calculator.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Opcode
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Opcode
+{
+    uint8_t opcode;
+    int     arity;
+    int64_t operand;
+    void (rpn::ByteCode::*emit)();
+    void (rpn::Translator::*translate)();
+    void (rpn::Listener::*interpret)();
+};
+
+uint64_t tsc_begin()
+{
+    _mm_lfence();
+    const uint64_t tsc = __rdtsc();
+    _mm_lfence();
+    return tsc;
+}
+
+uint64_t tsc_end()
+{
+    unsigned int   aux = 0;
+    const uint64_t tsc = __rdtscp(&aux);
+    _mm_lfence();
+    return tsc;
+}
+
+std::vector<int64_t> prefill(const Opcode& opcode, const uint64_t count)
+{
+    std::vector<int64_t> values;
+
+    if(opcode.arity == 1) {
+        values.push_back(3);
+        return values;
+    }
+    switch(opcode.opcode) {
+        case rpn::ByteCode::OP_MOD:
+            {
+                int64_t top = (INT64_C(1) << 62);
+                values.push_back(top);
+                for(uint64_t index = 0; index < count; ++index) {
+                    values.push_back((2 * top) - 1);
+                    top -= 1;
+                }
+                std::reverse(values.begin(), values.end());
+            }
+            break;
+        case rpn::ByteCode::OP_MUL:
+            values.assign(count + 1, -1);
+            break;
+        case rpn::ByteCode::OP_SHL:
+        case rpn::ByteCode::OP_SHR:
+            values.assign(count + 1, 0);
+            break;
+        default:
+            values.assign(count + 1, 3);
+            break;
+    }
+    return values;
+}
+
+double minimum(const std::vector<double>& samples)
+{
+    return *std::min_element(samples.begin(), samples.end());
+}
+
+std::string json(const double value)
+{
+    char buffer[64];
+
+    static_cast<void>(::snprintf(buffer, sizeof(buffer), "%.2f", value));
+
+    return buffer;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    using rpn::ByteCode;
+    using rpn::Translator;
+    using rpn::Listener;
+
+    const std::vector<Opcode> opcodes = {
+        { ByteCode::OP_ABS, 1, 0, &ByteCode::emit_abs, &Translator::emit_abs, &Listener::op_abs },
+        { ByteCode::OP_NEG, 1, 0, &ByteCode::emit_neg, &Translator::emit_neg, &Listener::op_neg },
+        { ByteCode::OP_ADD, 2, 3, &ByteCode::emit_add, &Translator::emit_add, &Listener::op_add },
+        { ByteCode::OP_SUB, 2, 3, &ByteCode::emit_sub, &Translator::emit_sub, &Listener::op_sub },
+        { ByteCode::OP_MUL, 2, 3, &ByteCode::emit_mul, &Translator::emit_mul, &Listener::op_mul },
+        { ByteCode::OP_DIV, 2, 3, &ByteCode::emit_div, &Translator::emit_div, &Listener::op_div },
+        { ByteCode::OP_MOD, 2, 7, &ByteCode::emit_mod, &Translator::emit_mod, &Listener::op_mod },
+        { ByteCode::OP_CPL, 1, 0, &ByteCode::emit_cpl, &Translator::emit_cpl, &Listener::op_cpl },
+        { ByteCode::OP_AND, 2, 3, &ByteCode::emit_and, &Translator::emit_and, &Listener::op_and },
+        { ByteCode::OP_IOR, 2, 3, &ByteCode::emit_ior, &Translator::emit_ior, &Listener::op_ior },
+        { ByteCode::OP_XOR, 2, 3, &ByteCode::emit_xor, &Translator::emit_xor, &Listener::op_xor },
+        { ByteCode::OP_SHL, 2, 1, &ByteCode::emit_shl, &Translator::emit_shl, &Listener::op_shl },
+        { ByteCode::OP_SHR, 2, 1, &ByteCode::emit_shr, &Translator::emit_shr, &Listener::op_shr },
+        { ByteCode::OP_INC, 1, 0, &ByteCode::emit_inc, &Translator::emit_inc, &Listener::op_inc },
+        { ByteCode::OP_DEC, 1, 0, &ByteCode::emit_dec, &Translator::emit_dec, &Listener::op_dec },
+    };
+    uint64_t samples = 101;
+    uint64_t count   = 1000;
+    bool     first   = true;
+
+    auto opt_value = [&](const std::string& argument, const char* prefix, uint64_t& value) -> bool
+    {
+        const size_t length = ::strlen(prefix);
+        if(argument.compare(0, length, prefix) == 0) {
+            value = std::max(::strtoull(argument.c_str() + length, nullptr, 10), 1ULL);
+            return true;
+        }
+        return false;
+    };
+
+    for(int argi = 1; argi < argc; ++argi) {
+        const std::string argument(argv[argi]);
+        if(opt_value(argument, "--samples=", samples)) {
+            continue;
+        }
+        if(opt_value(argument, "--count=", count)) {
+            continue;
+        }
+        std::cerr << "invalid argument" << ' ' << '<' << argument << '>' << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    rpn::Console    console(std::cin, std::cout, std::cerr);
+    rpn::Calculator calculator(console);
+    rpn::Listener&  listener(calculator);
+
+    auto interpreted = [&](const Opcode& opcode, const uint64_t repeat) -> double
+    {
+        const std::vector<int64_t> values(prefill(opcode, repeat));
+        std::vector<double>        timings;
+        for(uint64_t sample = 0; sample < samples; ++sample) {
+            listener.op_clr();
+            for(auto value : values) {
+                listener.op_i64(value);
+            }
+            const uint64_t t0 = tsc_begin();
+            for(uint64_t index = 0; index < repeat; ++index) {
+                (listener.*opcode.interpret)();
+            }
+            const uint64_t t1 = tsc_end();
+            timings.push_back(static_cast<double>(t1 - t0));
+        }
+        return minimum(timings);
+    };
+
+    auto translated = [&](const Opcode& opcode, const uint64_t repeat, const int mode, const bool immediate) -> double
+    {
+        const std::vector<int64_t> values(immediate ? std::vector<int64_t>(1, 1000) : prefill(opcode, repeat));
+        std::vector<double>        timings;
+        ByteCode                   bytecode;
+        rpn::HostCode              hostcode;
+        rpn::Function              function;
+        rpn::Operands              operands(values.size() + 16);
+
+        for(uint64_t index = 0; index < repeat; ++index) {
+            if(immediate && (opcode.arity == 2)) {
+                bytecode.emit_i64(opcode.operand);
+            }
+            (bytecode.*opcode.emit)();
+        }
+        Translator translator(bytecode, hostcode, function, mode);
+        translator.emit_prolog();
+        for(uint64_t index = 0; index < repeat; ++index) {
+            if(immediate && (opcode.arity == 2)) {
+                translator.emit_i64(opcode.operand);
+            }
+            (translator.*opcode.translate)();
+        }
+        translator.emit_epilog();
+        translator.emit_loop();
+        for(uint64_t sample = 0; sample < samples; ++sample) {
+            static_cast<void>(rpn::Operators::op_clr(operands));
+            for(auto value : values) {
+                static_cast<void>(rpn::Operators::op_i64(operands, value));
+            }
+            const uint64_t t0 = tsc_begin();
+            function.execute(operands);
+            const uint64_t t1 = tsc_end();
+            if(operands.status != rpn::Operands::STATUS_OK) {
+                throw std::runtime_error(std::string("unexpected status while running") + ' ' + '<' + ByteCode::mnemonic(opcode.opcode) + '>');
+            }
+            timings.push_back(static_cast<double>(t1 - t0));
+        }
+        return minimum(timings);
+    };
+
+    auto report = [&](const Opcode& opcode) -> void
+    {
+        const double interpreted_cost   = (interpreted(opcode, count) - interpreted(opcode, 0)) / count;
+        const double call_threaded_cost = (translated(opcode, count, Translator::MODE_BASELINE, false) - translated(opcode, 0, Translator::MODE_BASELINE, false)) / count;
+        const double inlined_cost       = (translated(opcode, count, Translator::MODE_OPTIMIZING, true) - translated(opcode, 0, Translator::MODE_OPTIMIZING, true)) / count;
+        std::cout << (first ? "" : ",") << std::endl;
+        std::cout << "    {"
+                  << " \"opcode\": \""        << ByteCode::mnemonic(opcode.opcode) << "\","
+                  << " \"interpreted\": "     << json(interpreted_cost)            << ","
+                  << " \"call_threaded\": "   << json(call_threaded_cost)          << ","
+                  << " \"inlined\": "         << json(inlined_cost)
+                  << " }";
+        first = false;
+    };
+
+    try {
+        calculator.set_debug(false);
+        calculator.set_trace(false);
+        calculator.set_print(false);
+        calculator.set_alert(false);
+        calculator.set_error(false);
+        calculator.set_stack(count + 16);
+        std::cout << "{" << std::endl;
+        std::cout << "  \"unit\": \"cycles/op\"," << std::endl;
+        std::cout << "  \"samples\": " << samples << "," << std::endl;
+        std::cout << "  \"count\": "   << count   << "," << std::endl;
+        std::cout << "  \"opcodes\": [";
+        for(auto& opcode : opcodes) {
+            report(opcode);
+        }
+        std::cout << std::endl << "  ]" << std::endl;
+        std::cout << "}" << std::endl;
+    }
+    catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,184 @@
+/*
+ * check_aot.cc - Copyright (c) 2023-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "State.h"
+#include "ByteCode.h"
+#include "HostCode.h"
+#include "Function.h"
+#include "Compiler.h"
+#include "Optimizer.h"
+#include "Interpreter.h"
+
+// ---------------------------------------------------------------------------
+// rpn_state
+// ---------------------------------------------------------------------------
+
+using rpn_state = rpn::Operands;
+
+extern "C" int64_t rpn_fib(rpn_state*);
+extern "C" int64_t rpn_fib_baseline(rpn_state*);
+extern "C" int64_t rpn_fib_tos(rpn_state*);
+extern "C" int64_t rpn_poly(rpn_state*);
+extern "C" int64_t rpn_regs(rpn_state*);
+extern "C" int64_t rpn_divs(rpn_state*);
+
+// ---------------------------------------------------------------------------
+// <anonymous>::Check
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Check
+{
+    const char*          name;
+    int64_t            (*function)(rpn_state*);
+    const char*          expression;
+    std::vector<int64_t> setup;
+    uint64_t             count;
+};
+
+bool underflow(const Check& check)
+{
+    rpn::Operands operands;
+    int64_t       result = (*check.function)(&operands);
+
+    const bool success = ((result == 0)
+                       && (operands.stack.depth == 0)
+                       && (operands.status == rpn::Operands::STATUS_UNDERFLOW));
+
+    std::cout << (success ? "ok  " : "FAIL") << ' ' << "rpn_" << check.name << ' ' << '<' << "empty stack" << '>' << ' ' << "underflow" << std::endl;
+
+    return success;
+}
+
+bool check(const Check& check)
+{
+    rpn::Operands expected;
+    rpn::Operands actual;
+    rpn::Operands shadow;
+    int64_t       result = 0;
+
+    auto same = [&](const rpn::Operands& lhs, const rpn::Operands& rhs) -> bool
+    {
+        if((lhs.stack.depth != rhs.stack.depth) || (lhs.status != rhs.status)) {
+            return false;
+        }
+        if(std::equal(lhs.stack.base, lhs.stack.base + lhs.stack.depth, rhs.stack.base) == false) {
+            return false;
+        }
+        return lhs.array == rhs.array;
+    };
+
+    auto setup = [&](rpn::Operands& operands) -> void
+    {
+        operands.array.fill(0);
+        for(auto value : check.setup) {
+            static_cast<void>(rpn::Operators::op_i64(operands, value));
+        }
+    };
+
+    auto interpret = [&]() -> void
+    {
+        rpn::ByteCode    bytecode;
+        rpn::HostCode    hostcode;
+        rpn::Function    function;
+        rpn::Compiler    compiler(bytecode, hostcode, function);
+        rpn::Optimizer   optimizer(bytecode);
+        rpn::Interpreter interpreter(expected, bytecode);
+
+        compiler.compile(check.expression);
+        optimizer.optimize();
+        interpreter.execute(check.count);
+    };
+
+    auto execute = [&]() -> void
+    {
+        for(uint64_t index = 0; index < check.count; ++index) {
+            result = (*check.function)(&actual);
+            static_cast<void>((*check.function)(&shadow));
+        }
+    };
+
+    setup(expected);
+    setup(actual);
+    setup(shadow);
+    interpret();
+    execute();
+
+    const bool success = ((result == rpn::Operators::op_top(expected))
+                       && same(actual, expected)
+                       && same(shadow, expected));
+
+    std::cout << (success ? "ok  " : "FAIL") << ' ' << "rpn_" << check.name << ' ' << '<' << check.expression << '>' << ' ' << result << std::endl;
+
+    return success;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    const std::vector<Check> checks = {
+        { "fib"         , &rpn_fib         , "fib"                                  , { 0, 1 }, 20 },
+        { "fib_baseline", &rpn_fib_baseline, "fib"                                  , { 0, 1 }, 20 },
+        { "fib_tos"     , &rpn_fib_tos     , "fib"                                  , { 0, 1 }, 20 },
+        { "poly"        , &rpn_poly        , "dup dup mul 3 mul xch 5 mul add 7 add", { 3    },  3 },
+        { "regs"        , &rpn_regs        , "dup 5 sto 5 rcl 3 mod add"            , { 10   },  5 },
+        { "divs"        , &rpn_divs        , "7 div 3 add 2 mul"                    , { 1000 },  3 },
+    };
+    int failures = 0;
+
+    try {
+        for(auto& entry : checks) {
+            if(check(entry) == false) {
+                ++failures;
+            }
+            if(underflow(entry) == false) {
+                ++failures;
+            }
+        }
+    }
+    catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return (failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------